@@ -0,0 +1,85 @@
+/*
+ * SPDX-FileCopyrightText: 2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Unlicense OR CC0-1.0
+ */
+#include <stdio.h>
+#include <inttypes.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "led_strip.h"
+#include "esp_timer.h"
+#include "esp_log.h"
+#include "esp_err.h"
+
+// GPIO assignment
+#define LED_STRIP_GPIO_PIN  2
+
+// 10MHz resolution, 1 tick = 0.1us (led strip needs a high resolution)
+#define LED_STRIP_RMT_RES_HZ  (10 * 1000 * 1000)
+
+// Number of frames refreshed for each measurement
+#define BENCHMARK_FRAMES  200
+
+// WS2812 timing: 24 bits of 1.25us per LED, plus the reset (latch) code the encoder appends after every frame
+#define WS2812_LED_TIME_NS   (24 * 1250)
+#define WS2812_RESET_TIME_US 280
+
+static const char *TAG = "example";
+
+static const uint32_t s_led_counts[] = {1, 64, 512};
+
+static led_strip_handle_t configure_led(uint32_t led_count, bool keep_enabled)
+{
+    led_strip_config_t strip_config = {
+        .strip_gpio_num = LED_STRIP_GPIO_PIN,
+        .max_leds = led_count,
+        .led_model = LED_MODEL_WS2812,
+        .color_component_format = LED_STRIP_COLOR_COMPONENT_FMT_GRB,
+    };
+    led_strip_rmt_config_t rmt_config = {
+        .clk_src = RMT_CLK_SRC_DEFAULT,
+        .resolution_hz = LED_STRIP_RMT_RES_HZ,
+        .flags = {
+            .keep_enabled = keep_enabled, // enable the RMT channel once, instead of around every refresh
+        }
+    };
+
+    led_strip_handle_t led_strip;
+    ESP_ERROR_CHECK(led_strip_new_rmt_device(&strip_config, &rmt_config, &led_strip));
+    return led_strip;
+}
+
+// Refresh the whole strip as fast as possible and return the achieved frame rate, in frames per second
+static float measure_frame_rate(led_strip_handle_t led_strip, uint32_t led_count)
+{
+    int64_t start_us = esp_timer_get_time();
+    for (int frame = 0; frame < BENCHMARK_FRAMES; frame++) {
+        for (uint32_t i = 0; i < led_count; i++) {
+            ESP_ERROR_CHECK(led_strip_set_pixel(led_strip, i, frame & 0x0F, 0, 0));
+        }
+        ESP_ERROR_CHECK(led_strip_refresh(led_strip));
+    }
+    int64_t elapsed_us = esp_timer_get_time() - start_us;
+    return BENCHMARK_FRAMES * 1000000.0f / elapsed_us;
+}
+
+void app_main(void)
+{
+    ESP_LOGI(TAG, "Measuring maximum frame rate over %d frames", BENCHMARK_FRAMES);
+    for (size_t n = 0; n < sizeof(s_led_counts) / sizeof(s_led_counts[0]); n++) {
+        uint32_t led_count = s_led_counts[n];
+        float fps[2];
+        for (int keep_enabled = 0; keep_enabled < 2; keep_enabled++) {
+            led_strip_handle_t led_strip = configure_led(led_count, keep_enabled);
+            fps[keep_enabled] = measure_frame_rate(led_strip, led_count);
+            ESP_ERROR_CHECK(led_strip_clear(led_strip));
+            ESP_ERROR_CHECK(led_strip_del(led_strip));
+        }
+        // upper bound set by the wire protocol itself
+        float wire_fps = 1000000.0f / (led_count * WS2812_LED_TIME_NS / 1000.0f + WS2812_RESET_TIME_US);
+        ESP_LOGI(TAG, "%4"PRIu32" LEDs: enable per refresh %7.1f fps, keep enabled %7.1f fps, wire limit %7.1f fps",
+                 led_count, fps[0], fps[1], wire_fps);
+    }
+    ESP_LOGI(TAG, "Benchmark done");
+}
@@ -0,0 +1,79 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// Host microbenchmark of the SPI encoder and clear, 3.0.1 implementation against the current one.
+// Only the ratio is meaningful: the absolute figures depend on the host, not on the target.
+#include <stdio.h>
+#include <time.h>
+#include "led_strip_spi_encoder.h"
+#include "spi_encoder_ref.h"
+
+#define BENCH_COLOR_BYTES (1024 * 3) // 1024 RGB pixels
+#define BENCH_ROUNDS 20000
+
+static uint8_t s_colors[BENCH_COLOR_BYTES];
+static uint8_t s_spi_buf[BENCH_COLOR_BYTES * SPI_BYTES_PER_COLOR_BYTE];
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// keep the compiler from dropping the writes to the buffer
+static inline void consume(void)
+{
+    __asm__ volatile("" : : "r"(s_spi_buf) : "memory");
+}
+
+int main(void)
+{
+    double start, ref_s, new_s;
+    double color_mb = (double)BENCH_COLOR_BYTES * BENCH_ROUNDS / 1e6;
+
+    for (int i = 0; i < BENCH_COLOR_BYTES; i++) {
+        s_colors[i] = i * 37;
+    }
+
+    // the reference ORs into the buffer, so it pays for zeroing it first as set_pixel did through the clear
+    start = now_s();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        memset(s_spi_buf, 0, sizeof(s_spi_buf));
+        for (int i = 0; i < BENCH_COLOR_BYTES; i++) {
+            ref_led_strip_spi_bit(s_colors[i] ^ round, &s_spi_buf[i * SPI_BYTES_PER_COLOR_BYTE]);
+        }
+        consume();
+    }
+    ref_s = now_s() - start;
+
+    start = now_s();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int i = 0; i < BENCH_COLOR_BYTES; i++) {
+            __led_strip_spi_bit(s_colors[i] ^ round, &s_spi_buf[i * SPI_BYTES_PER_COLOR_BYTE]);
+        }
+        consume();
+    }
+    new_s = now_s() - start;
+    printf("encode: 3.0.1 %.1f MB/s, nibble table %.1f MB/s (x%.2f)\n",
+           color_mb / ref_s, color_mb / new_s, ref_s / new_s);
+
+    start = now_s();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        ref_led_strip_spi_fill_off(s_spi_buf, sizeof(s_spi_buf));
+        consume();
+    }
+    ref_s = now_s() - start;
+
+    start = now_s();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        __led_strip_spi_fill_off(s_spi_buf, sizeof(s_spi_buf));
+        consume();
+    }
+    new_s = now_s() - start;
+    printf("clear:  3.0.1 %.1f MB/s, pattern fill %.1f MB/s (x%.2f)\n",
+           color_mb / ref_s, color_mb / new_s, ref_s / new_s);
+    return 0;
+}
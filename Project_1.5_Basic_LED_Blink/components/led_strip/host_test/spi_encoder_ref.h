@@ -0,0 +1,39 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifndef BIT
+#define BIT(nr) (1UL << (nr))
+#endif
+
+// SPI encoder and clear of led_strip 3.0.1, kept as the reference for the nibble table version
+
+// ORs the pattern into buf, which must be zeroed beforehand
+static inline void ref_led_strip_spi_bit(uint8_t data, uint8_t *buf)
+{
+    *(buf + 2) |= data & BIT(0) ? BIT(2) | BIT(1) : BIT(2);
+    *(buf + 2) |= data & BIT(1) ? BIT(5) | BIT(4) : BIT(5);
+    *(buf + 2) |= data & BIT(2) ? BIT(7) : 0x00;
+    *(buf + 1) |= BIT(0);
+    *(buf + 1) |= data & BIT(3) ? BIT(3) | BIT(2) : BIT(3);
+    *(buf + 1) |= data & BIT(4) ? BIT(6) | BIT(5) : BIT(6);
+    *(buf + 0) |= data & BIT(5) ? BIT(1) | BIT(0) : BIT(1);
+    *(buf + 0) |= data & BIT(6) ? BIT(4) | BIT(3) : BIT(4);
+    *(buf + 0) |= data & BIT(7) ? BIT(7) | BIT(6) : BIT(7);
+}
+
+static inline void ref_led_strip_spi_fill_off(uint8_t *buf, size_t size)
+{
+    memset(buf, 0, size);
+    for (size_t index = 0; index < size / 3; index++) {
+        ref_led_strip_spi_bit(0, buf);
+        buf += 3;
+    }
+}
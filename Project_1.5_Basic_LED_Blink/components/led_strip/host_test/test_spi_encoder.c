@@ -0,0 +1,59 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+// Checks the nibble table SPI encoder and the pattern fill clear against the 3.0.1 implementation
+#include <stdio.h>
+#include "led_strip_spi_encoder.h"
+#include "spi_encoder_ref.h"
+
+#define FILL_MAX_BYTES (512 * 4 * SPI_BYTES_PER_COLOR_BYTE) // 512 RGBW pixels
+#define GUARD_BYTE 0xA5
+
+static int check_encoder(void)
+{
+    int failures = 0;
+    for (int value = 0; value < 256; value++) {
+        uint8_t expected[SPI_BYTES_PER_COLOR_BYTE] = {0};
+        // the table version overwrites the bytes, so stale content must not leak into the result
+        uint8_t actual[SPI_BYTES_PER_COLOR_BYTE] = {0xFF, 0xFF, 0xFF};
+        ref_led_strip_spi_bit(value, expected);
+        __led_strip_spi_bit(value, actual);
+        if (memcmp(expected, actual, sizeof(expected)) != 0) {
+            printf("FAIL: 0x%02X encodes to %02X %02X %02X, expected %02X %02X %02X\n", value,
+                   actual[0], actual[1], actual[2], expected[0], expected[1], expected[2]);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+static int check_fill_off(void)
+{
+    static uint8_t expected[FILL_MAX_BYTES];
+    static uint8_t actual[FILL_MAX_BYTES + 1];
+    int failures = 0;
+
+    for (size_t size = 0; size <= FILL_MAX_BYTES; size += SPI_BYTES_PER_COLOR_BYTE) {
+        ref_led_strip_spi_fill_off(expected, size);
+        memset(actual, GUARD_BYTE, sizeof(actual));
+        __led_strip_spi_fill_off(actual, size);
+        if (memcmp(expected, actual, size) != 0 || actual[size] != GUARD_BYTE) {
+            printf("FAIL: clear of %zu bytes differs from the reference or overruns the buffer\n", size);
+            failures++;
+        }
+    }
+    return failures;
+}
+
+int main(void)
+{
+    int failures = check_encoder() + check_fill_off();
+    if (failures) {
+        printf("%d checks failed\n", failures);
+        return 1;
+    }
+    printf("OK: 256 color bytes and every clear size up to %d bytes match led_strip 3.0.1\n", FILL_MAX_BYTES);
+    return 0;
+}
@@ -0,0 +1,203 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "led_strip_rmt.h"
+#include "led_strip_spi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Set RGB for a specific pixel
+ *
+ * @param strip: LED strip
+ * @param index: index of pixel to set
+ * @param red: red part of color
+ * @param green: green part of color
+ * @param blue: blue part of color
+ *
+ * @return
+ *      - ESP_OK: Set RGB for a specific pixel successfully
+ *      - ESP_ERR_INVALID_ARG: Set RGB for a specific pixel failed because of invalid parameters
+ *      - ESP_FAIL: Set RGB for a specific pixel failed because other error occurred
+ */
+esp_err_t led_strip_set_pixel(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue);
+
+/**
+ * @brief Set RGBW for a specific pixel
+ *
+ * @note Only call this function if your led strip does have the white component (e.g. SK6812-RGBW)
+ * @note Also see `led_strip_set_pixel` if you only want to specify the RGB part of the color and bypass the white component
+ *
+ * @param strip: LED strip
+ * @param index: index of pixel to set
+ * @param red: red part of color
+ * @param green: green part of color
+ * @param blue: blue part of color
+ * @param white: separate white component
+ *
+ * @return
+ *      - ESP_OK: Set RGBW color for a specific pixel successfully
+ *      - ESP_ERR_INVALID_ARG: Set RGBW color for a specific pixel failed because of an invalid argument
+ *      - ESP_FAIL: Set RGBW color for a specific pixel failed because other error occurred
+ */
+esp_err_t led_strip_set_pixel_rgbw(led_strip_handle_t strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white);
+
+/**
+ * @brief Set HSV for a specific pixel
+ *
+ * @param strip: LED strip
+ * @param index: index of pixel to set
+ * @param hue: hue part of color (0 - 360)
+ * @param saturation: saturation part of color (0 - 255, rescaled from 0 - 1. e.g. saturation = 0.5, rescaled to 127)
+ * @param value: value part of color (0 - 255, rescaled from 0 - 1. e.g. value = 0.5, rescaled to 127)
+ *
+ * @return
+ *      - ESP_OK: Set HSV color for a specific pixel successfully
+ *      - ESP_ERR_INVALID_ARG: Set HSV color for a specific pixel failed because of an invalid argument
+ *      - ESP_FAIL: Set HSV color for a specific pixel failed because other error occurred
+ */
+esp_err_t led_strip_set_pixel_hsv(led_strip_handle_t strip, uint32_t index, uint16_t hue, uint8_t saturation, uint8_t value);
+
+/**
+ * @brief Set a run of consecutive pixels from a framebuffer
+ *
+ * @note Much cheaper than calling `led_strip_set_pixel` for every pixel. If `format` matches the color component
+ *       format of the strip, the pixels are copied as is.
+ * @note If the source has a white component but the strip doesn't, it's dropped. If the strip has a white component
+ *       but the source doesn't, it's set to zero, like `led_strip_set_pixel` does.
+ *
+ * @param strip: LED strip
+ * @param start: index of the first pixel to set
+ * @param count: number of pixels to set
+ * @param pixels: source pixels, `format.format.num_components` bytes per pixel, 8 bits per color component
+ * @param format: order and number of color components in `pixels`, e.g. `LED_STRIP_COLOR_COMPONENT_FMT_RGB`.
+ *                A `num_components` of 0 is taken as 3
+ *
+ * @return
+ *      - ESP_OK: Set pixels successfully
+ *      - ESP_ERR_INVALID_ARG: Set pixels failed because of invalid parameters, or the run is out of the strip
+ *      - ESP_ERR_NOT_SUPPORTED: The backend of this strip doesn't support setting pixels in bulk
+ *      - ESP_FAIL: Set pixels failed because other error occurred
+ */
+esp_err_t led_strip_set_pixels(led_strip_handle_t strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_color_component_format_t format);
+
+/**
+ * @brief Refresh memory colors to LEDs
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh successfully
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ *
+ * @note:
+ *      After updating the LED colors in the memory, a following invocation of this API is needed to flush colors to strip.
+ */
+esp_err_t led_strip_refresh(led_strip_handle_t strip);
+
+/**
+ * @brief Start flushing memory colors to LEDs and return without waiting for the transmission
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Refresh started successfully
+ *      - ESP_ERR_NOT_SUPPORTED: The backend of this strip only supports the blocking `led_strip_refresh`
+ *      - ESP_FAIL: Refresh failed because some other error occurred
+ *
+ * @note:
+ *      With the RMT backend and `led_strip_rmt_config_t::flags::double_buffer` enabled, the pixel buffer is swapped on
+ *      every call, so the next frame can be composed with `led_strip_set_pixel` while the current one is on the wire.
+ *      Without double buffering, the next pixel update waits until the transmission finishes.
+ *      With the RMT backend the channel is enabled by this call and stays enabled until `led_strip_refresh_wait_done`
+ *      or a blocking `led_strip_refresh` has flushed every queued frame, which disable it again unless
+ *      `led_strip_rmt_config_t::flags::keep_enabled` is set. Set that flag to avoid re-enabling the channel for each
+ *      batch of asynchronous refreshes.
+ */
+esp_err_t led_strip_refresh_async(led_strip_handle_t strip);
+
+/**
+ * @brief Wait until all the refreshes started by `led_strip_refresh_async` are transmitted
+ *
+ * @note With the RMT backend the channel is disabled once all frames are out, unless
+ *       `led_strip_rmt_config_t::flags::keep_enabled` is set
+ *
+ * @param strip: LED strip
+ * @param timeout_ms: timeout value in milliseconds, -1 means wait forever
+ *
+ * @return
+ *      - ESP_OK: All refreshes are done
+ *      - ESP_ERR_TIMEOUT: Wait timed out
+ *      - ESP_ERR_NOT_SUPPORTED: The backend of this strip doesn't support asynchronous refresh
+ */
+esp_err_t led_strip_refresh_wait_done(led_strip_handle_t strip, int32_t timeout_ms);
+
+/**
+ * @brief Register a callback to be notified when an asynchronous refresh has been transmitted
+ *
+ * @note The callback is invoked from ISR context
+ *
+ * @param strip: LED strip
+ * @param cb: callback function, set to NULL to unregister
+ * @param user_ctx: user context passed to the callback
+ *
+ * @return
+ *      - ESP_OK: Register callback successfully
+ *      - ESP_ERR_NOT_SUPPORTED: The backend of this strip doesn't support asynchronous refresh
+ */
+esp_err_t led_strip_register_refresh_done_callback(led_strip_handle_t strip, led_strip_refresh_done_cb_t cb, void *user_ctx);
+
+/**
+ * @brief Attach a framebuffer owned by the user, so refreshes transmit straight from it without any copy
+ *
+ * @note The framebuffer holds `max_leds` pixels in the color component format of the strip (the wire order),
+ *       e.g. G, R, B bytes for `LED_STRIP_COLOR_COMPONENT_FMT_GRB`. It must stay valid until another framebuffer is
+ *       attached, it's detached or the strip is deleted. `led_strip_set_pixel` and `led_strip_clear` write into it.
+ * @note The function returns once no queued frame is reading `frame_buf` anymore, so it's safe to render into it.
+ *       Swapping two framebuffers around `led_strip_refresh_async` lets the next frame be rendered while the current
+ *       one is on the wire, without any copy. Don't touch a framebuffer after refreshing it until it's attached again.
+ *
+ * @param strip: LED strip
+ * @param frame_buf: framebuffer, set to NULL to go back to the internal pixel buffer of the strip
+ *
+ * @return
+ *      - ESP_OK: Attach framebuffer successfully
+ *      - ESP_ERR_INVALID_ARG: Attach framebuffer failed because of invalid parameters
+ *      - ESP_ERR_NOT_SUPPORTED: The backend of this strip can't transmit from an external framebuffer
+ *      - ESP_FAIL: Attach framebuffer failed because some other error occurred
+ */
+esp_err_t led_strip_attach_framebuffer(led_strip_handle_t strip, uint8_t *frame_buf);
+
+/**
+ * @brief Clear LED strip (turn off all LEDs)
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Clear LEDs successfully
+ *      - ESP_FAIL: Clear LEDs failed because some other error occurred
+ */
+esp_err_t led_strip_clear(led_strip_handle_t strip);
+
+/**
+ * @brief Free LED strip resources
+ *
+ * @param strip: LED strip
+ *
+ * @return
+ *      - ESP_OK: Free resources successfully
+ *      - ESP_FAIL: Free resources failed because error occurred
+ */
+esp_err_t led_strip_del(led_strip_handle_t strip);
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,6 +25,10 @@ typedef struct {
     /*!< Extra RMT specific driver flags */
     struct led_strip_rmt_extra_config {
         uint32_t with_dma: 1;   /*!< Use DMA to transmit data */
+        uint32_t double_buffer: 1; /*!< Allocate a second pixel buffer, so the next frame can be composed while the
+                                        current one is transmitted by `led_strip_refresh_async` */
+        uint32_t keep_enabled: 1;  /*!< Enable the RMT channel once when the strip is created and keep it enabled until
+                                        `led_strip_del`, instead of enabling and disabling it around every refresh */
     } flags;                    /*!< Extra driver flags */
 } led_strip_rmt_config_t;
 
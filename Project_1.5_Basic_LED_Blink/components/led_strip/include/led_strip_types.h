@@ -6,6 +6,7 @@
 #pragma once
 
 #include <stdint.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -16,6 +17,17 @@ extern "C" {
  */
 typedef struct led_strip_t *led_strip_handle_t;
 
+/**
+ * @brief Callback invoked when an asynchronous refresh has been fully transmitted
+ *
+ * @note Called from ISR context, so it must not block and should only use ISR-safe APIs
+ *
+ * @param strip LED strip handle
+ * @param user_ctx User context passed to `led_strip_register_refresh_done_callback`
+ * @return Whether a high priority task has been woken up by this callback
+ */
+typedef bool (*led_strip_refresh_done_cb_t)(led_strip_handle_t strip, void *user_ctx);
+
 /**
  * @brief LED strip model
  * @note Different led model may have different timing parameters, so we need to distinguish them.
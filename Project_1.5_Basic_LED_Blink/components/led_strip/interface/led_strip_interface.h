@@ -0,0 +1,169 @@
+/*
+ * SPDX-FileCopyrightText: 2022 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "led_strip_types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct led_strip_t led_strip_t; /*!< Type of LED strip */
+
+/**
+ * @brief LED strip interface definition
+ */
+struct led_strip_t {
+    /**
+     * @brief Set RGB for a specific pixel
+     *
+     * @param strip: LED strip
+     * @param index: index of pixel to set
+     * @param red: red part of color
+     * @param green: green part of color
+     * @param blue: blue part of color
+     *
+     * @return
+     *      - ESP_OK: Set RGB for a specific pixel successfully
+     *      - ESP_ERR_INVALID_ARG: Set RGB for a specific pixel failed because of invalid parameters
+     *      - ESP_FAIL: Set RGB for a specific pixel failed because other error occurred
+     */
+    esp_err_t (*set_pixel)(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue);
+
+    /**
+     * @brief Set RGBW for a specific pixel. Similar to `set_pixel` but also set the white component
+     *
+     * @param strip: LED strip
+     * @param index: index of pixel to set
+     * @param red: red part of color
+     * @param green: green part of color
+     * @param blue: blue part of color
+     * @param white: separate white component
+     *
+     * @return
+     *      - ESP_OK: Set RGBW color for a specific pixel successfully
+     *      - ESP_ERR_INVALID_ARG: Set RGBW color for a specific pixel failed because of an invalid argument
+     *      - ESP_FAIL: Set RGBW color for a specific pixel failed because other error occurred
+     */
+    esp_err_t (*set_pixel_rgbw)(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white);
+
+    /**
+     * @brief Set a run of consecutive pixels from a buffer
+     *
+     * @param strip: LED strip
+     * @param start: index of the first pixel to set
+     * @param count: number of pixels to set
+     * @param pixels: source pixels, `format.format.num_components` bytes per pixel
+     * @param format: order and number of color components in the source buffer, already validated by the caller
+     *
+     * @return
+     *      - ESP_OK: Set pixels successfully
+     *      - ESP_ERR_INVALID_ARG: Set pixels failed because the run is out of the strip
+     *      - ESP_FAIL: Set pixels failed because other error occurred
+     *
+     * @note Optional, a backend that leaves it NULL only supports setting pixels one by one
+     */
+    esp_err_t (*set_pixels)(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_color_component_format_t format);
+
+    /**
+     * @brief Refresh memory colors to LEDs
+     *
+     * @param strip: LED strip
+     * @param timeout_ms: timeout value for refreshing task
+     *
+     * @return
+     *      - ESP_OK: Refresh successfully
+     *      - ESP_FAIL: Refresh failed because some other error occurred
+     *
+     * @note:
+     *      After updating the LED colors in the memory, a following invocation of this API is needed to flush colors to strip.
+     */
+    esp_err_t (*refresh)(led_strip_t *strip);
+
+    /**
+     * @brief Start flushing memory colors to LEDs without waiting for the transmission to finish
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Refresh started successfully
+     *      - ESP_FAIL: Refresh failed because some other error occurred
+     *
+     * @note Optional, a backend that leaves it NULL only supports the blocking `refresh`
+     */
+    esp_err_t (*refresh_async)(led_strip_t *strip);
+
+    /**
+     * @brief Wait until all pending asynchronous refreshes are transmitted
+     *
+     * @param strip: LED strip
+     * @param timeout_ms: timeout value, -1 means wait forever
+     *
+     * @return
+     *      - ESP_OK: All refreshes are done
+     *      - ESP_ERR_TIMEOUT: Wait timed out
+     *
+     * @note Optional, may be NULL if `refresh_async` is NULL
+     */
+    esp_err_t (*wait_refresh_done)(led_strip_t *strip, int32_t timeout_ms);
+
+    /**
+     * @brief Register a callback invoked (in ISR context) when an asynchronous refresh completes
+     *
+     * @param strip: LED strip
+     * @param cb: callback function, NULL to unregister
+     * @param user_ctx: user context passed to the callback
+     *
+     * @return
+     *      - ESP_OK: Register callback successfully
+     *
+     * @note Optional, may be NULL if `refresh_async` is NULL
+     */
+    esp_err_t (*register_refresh_done_cb)(led_strip_t *strip, led_strip_refresh_done_cb_t cb, void *user_ctx);
+
+    /**
+     * @brief Transmit the following frames straight from a buffer owned by the user
+     *
+     * @param strip: LED strip
+     * @param frame_buf: framebuffer in the wire order of the strip, NULL to go back to the internal pixel buffer
+     *
+     * @return
+     *      - ESP_OK: Attach framebuffer successfully, no queued frame is reading it anymore
+     *      - ESP_FAIL: Attach framebuffer failed because some other error occurred
+     *
+     * @note Optional, a backend that leaves it NULL always transmits from its own pixel buffer
+     */
+    esp_err_t (*attach_framebuffer)(led_strip_t *strip, uint8_t *frame_buf);
+
+    /**
+     * @brief Clear LED strip (turn off all LEDs)
+     *
+     * @param strip: LED strip
+     * @param timeout_ms: timeout value for clearing task
+     *
+     * @return
+     *      - ESP_OK: Clear LEDs successfully
+     *      - ESP_FAIL: Clear LEDs failed because some other error occurred
+     */
+    esp_err_t (*clear)(led_strip_t *strip);
+
+    /**
+     * @brief Free LED strip resources
+     *
+     * @param strip: LED strip
+     *
+     * @return
+     *      - ESP_OK: Free resources successfully
+     *      - ESP_FAIL: Free resources failed because error occurred
+     */
+    esp_err_t (*del)(led_strip_t *strip);
+};
+
+#ifdef __cplusplus
+}
+#endif
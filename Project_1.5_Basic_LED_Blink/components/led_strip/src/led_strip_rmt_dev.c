@@ -0,0 +1,396 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <sys/cdefs.h>
+#include "esp_log.h"
+#include "esp_check.h"
+#include "esp_attr.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
+#include "driver/rmt_tx.h"
+#include "led_strip.h"
+#include "led_strip_interface.h"
+#include "led_strip_rmt_encoder.h"
+
+#define LED_STRIP_RMT_DEFAULT_RESOLUTION 10000000 // 10MHz resolution
+#define LED_STRIP_RMT_DEFAULT_TRANS_QUEUE_SIZE 4
+// the memory size of each RMT channel, in words (4 bytes)
+#if CONFIG_IDF_TARGET_ESP32 || CONFIG_IDF_TARGET_ESP32S2
+#define LED_STRIP_RMT_DEFAULT_MEM_BLOCK_SYMBOLS 64
+#else
+#define LED_STRIP_RMT_DEFAULT_MEM_BLOCK_SYMBOLS 48
+#endif
+
+static const char *TAG = "led_strip_rmt";
+
+typedef struct {
+    led_strip_t base;
+    rmt_channel_handle_t rmt_chan;
+    rmt_encoder_handle_t strip_encoder;
+    SemaphoreHandle_t done_sem;         // given from the ISR every time a frame is transmitted
+    led_strip_refresh_done_cb_t on_refresh_done;
+    void *user_ctx;
+    volatile uint32_t done_count;       // number of frames transmitted, increased in the ISR
+    uint32_t submit_count;              // number of frames handed to the RMT driver
+    uint32_t buf_submit_seq[2];         // submit_count of the last frame read from each pixel buffer
+    uint32_t strip_len;
+    uint8_t bytes_per_pixel;
+    uint8_t num_buffers;
+    uint8_t back_index;                 // index of the buffer that set_pixel writes to
+    bool back_needs_sync;               // back buffer still holds the frame before the last submitted one
+    bool chan_enabled;
+    bool keep_enabled;                  // channel stays enabled between frames, set by the config flag only
+    bool external_fb;                   // frames are transmitted straight from a buffer attached by the user
+    led_color_component_format_t component_fmt;
+    uint8_t *frame_bufs[2];             // buffer behind each slot, internal or attached by the user
+    uint8_t *pixel_buf;                 // points to the back buffer
+    uint8_t pixel_bufs[];
+} led_strip_rmt_obj;
+
+static bool IRAM_ATTR led_strip_rmt_trans_done_cb(rmt_channel_handle_t tx_chan, const rmt_tx_done_event_data_t *edata, void *user_ctx)
+{
+    led_strip_rmt_obj *rmt_strip = (led_strip_rmt_obj *)user_ctx;
+    BaseType_t task_woken = pdFALSE;
+    bool need_yield = false;
+
+    rmt_strip->done_count++;
+    xSemaphoreGiveFromISR(rmt_strip->done_sem, &task_woken);
+    need_yield = (task_woken == pdTRUE);
+    if (rmt_strip->on_refresh_done) {
+        need_yield |= rmt_strip->on_refresh_done(&rmt_strip->base, rmt_strip->user_ctx);
+    }
+    return need_yield;
+}
+
+static esp_err_t led_strip_rmt_wait_buffer(led_strip_rmt_obj *rmt_strip, uint8_t index, int32_t timeout_ms)
+{
+    TickType_t ticks = timeout_ms < 0 ? portMAX_DELAY : pdMS_TO_TICKS(timeout_ms);
+    // frames complete in submission order, so the buffer is free once the frame that read it is done
+    while ((int32_t)(rmt_strip->done_count - rmt_strip->buf_submit_seq[index]) < 0) {
+        ESP_RETURN_ON_FALSE(xSemaphoreTake(rmt_strip->done_sem, ticks) == pdTRUE, ESP_ERR_TIMEOUT, TAG, "wait pixel buffer timeout");
+    }
+    return ESP_OK;
+}
+
+// Make the back buffer writable: wait for the frame still reading it and bring it up to date with the last frame
+static esp_err_t led_strip_rmt_acquire_back(led_strip_rmt_obj *rmt_strip)
+{
+    ESP_RETURN_ON_ERROR(led_strip_rmt_wait_buffer(rmt_strip, rmt_strip->back_index, -1), TAG, "wait back buffer failed");
+    if (rmt_strip->back_needs_sync) {
+        memcpy(rmt_strip->pixel_buf, rmt_strip->frame_bufs[rmt_strip->back_index ^ 1], rmt_strip->strip_len * rmt_strip->bytes_per_pixel);
+        rmt_strip->back_needs_sync = false;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(index < rmt_strip->strip_len, ESP_ERR_INVALID_ARG, TAG, "index out of maximum number of LEDs");
+
+    led_color_component_format_t component_fmt = rmt_strip->component_fmt;
+    ESP_RETURN_ON_ERROR(led_strip_rmt_acquire_back(rmt_strip), TAG, "acquire pixel buffer failed");
+    uint32_t start = index * rmt_strip->bytes_per_pixel;
+    uint8_t *pixel_buf = rmt_strip->pixel_buf;
+
+    pixel_buf[start + component_fmt.format.r_pos] = red & 0xFF;
+    pixel_buf[start + component_fmt.format.g_pos] = green & 0xFF;
+    pixel_buf[start + component_fmt.format.b_pos] = blue & 0xFF;
+    if (component_fmt.format.num_components > 3) {
+        pixel_buf[start + component_fmt.format.w_pos] = 0;
+    }
+
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_set_pixel_rgbw(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue, uint32_t white)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    led_color_component_format_t component_fmt = rmt_strip->component_fmt;
+    ESP_RETURN_ON_FALSE(index < rmt_strip->strip_len, ESP_ERR_INVALID_ARG, TAG, "index out of maximum number of LEDs");
+    ESP_RETURN_ON_FALSE(component_fmt.format.num_components == 4, ESP_ERR_INVALID_ARG, TAG, "led doesn't have 4 components");
+
+    ESP_RETURN_ON_ERROR(led_strip_rmt_acquire_back(rmt_strip), TAG, "acquire pixel buffer failed");
+    uint32_t start = index * rmt_strip->bytes_per_pixel;
+    uint8_t *pixel_buf = rmt_strip->pixel_buf;
+
+    pixel_buf[start + component_fmt.format.r_pos] = red & 0xFF;
+    pixel_buf[start + component_fmt.format.g_pos] = green & 0xFF;
+    pixel_buf[start + component_fmt.format.b_pos] = blue & 0xFF;
+    pixel_buf[start + component_fmt.format.w_pos] = white & 0xFF;
+
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_color_component_format_t format)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    ESP_RETURN_ON_FALSE(start <= rmt_strip->strip_len && count <= rmt_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG, "pixels out of maximum number of LEDs");
+
+    led_color_component_format_t component_fmt = rmt_strip->component_fmt;
+    uint8_t bytes_per_pixel = rmt_strip->bytes_per_pixel;
+    uint8_t src_bytes_per_pixel = format.format.num_components;
+    ESP_RETURN_ON_ERROR(led_strip_rmt_acquire_back(rmt_strip), TAG, "acquire pixel buffer failed");
+    uint8_t *pixel_buf = rmt_strip->pixel_buf + start * bytes_per_pixel;
+
+    if (src_bytes_per_pixel == bytes_per_pixel && format.format.r_pos == component_fmt.format.r_pos &&
+            format.format.g_pos == component_fmt.format.g_pos && format.format.b_pos == component_fmt.format.b_pos &&
+            (bytes_per_pixel == 3 || format.format.w_pos == component_fmt.format.w_pos)) {
+        // the source is already in the wire order of the strip
+        memcpy(pixel_buf, pixels, count * bytes_per_pixel);
+        return ESP_OK;
+    }
+
+    uint8_t r_pos = component_fmt.format.r_pos, src_r_pos = format.format.r_pos;
+    uint8_t g_pos = component_fmt.format.g_pos, src_g_pos = format.format.g_pos;
+    uint8_t b_pos = component_fmt.format.b_pos, src_b_pos = format.format.b_pos;
+    uint8_t w_pos = component_fmt.format.w_pos, src_w_pos = format.format.w_pos;
+    for (uint32_t i = 0; i < count; i++) {
+        pixel_buf[r_pos] = pixels[src_r_pos];
+        pixel_buf[g_pos] = pixels[src_g_pos];
+        pixel_buf[b_pos] = pixels[src_b_pos];
+        if (bytes_per_pixel > 3) {
+            pixel_buf[w_pos] = src_bytes_per_pixel > 3 ? pixels[src_w_pos] : 0;
+        }
+        pixel_buf += bytes_per_pixel;
+        pixels += src_bytes_per_pixel;
+    }
+    return ESP_OK;
+}
+
+// Hand the back buffer to the RMT driver and, with double buffering, swap buffers
+static esp_err_t led_strip_rmt_submit(led_strip_rmt_obj *rmt_strip)
+{
+    rmt_transmit_config_t tx_conf = {
+        .loop_count = 0,
+    };
+
+    // the back buffer may still be stale if nothing was written since the last swap
+    ESP_RETURN_ON_ERROR(led_strip_rmt_acquire_back(rmt_strip), TAG, "acquire pixel buffer failed");
+    if (!rmt_strip->chan_enabled) {
+        ESP_RETURN_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), TAG, "enable RMT channel failed");
+        rmt_strip->chan_enabled = true;
+    }
+    ESP_RETURN_ON_ERROR(rmt_transmit(rmt_strip->rmt_chan, rmt_strip->strip_encoder, rmt_strip->pixel_buf,
+                                     rmt_strip->strip_len * rmt_strip->bytes_per_pixel, &tx_conf), TAG, "transmit pixels by RMT failed");
+    rmt_strip->submit_count++;
+    rmt_strip->buf_submit_seq[rmt_strip->back_index] = rmt_strip->submit_count;
+
+    // an attached framebuffer is swapped by the user, not here
+    if (rmt_strip->num_buffers > 1 && !rmt_strip->external_fb) {
+        rmt_strip->back_index ^= 1;
+        rmt_strip->pixel_buf = rmt_strip->frame_bufs[rmt_strip->back_index];
+        rmt_strip->back_needs_sync = true;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+
+    ESP_RETURN_ON_ERROR(led_strip_rmt_submit(rmt_strip), TAG, "submit pixels failed");
+    ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
+    if (!rmt_strip->keep_enabled) {
+        ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+        rmt_strip->chan_enabled = false;
+    }
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_refresh_async(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+
+    // the channel stays enabled while frames are queued, wait_refresh_done disables it again
+    return led_strip_rmt_submit(rmt_strip);
+}
+
+static esp_err_t led_strip_rmt_wait_refresh_done(led_strip_t *strip, int32_t timeout_ms)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    if (!rmt_strip->chan_enabled) {
+        return ESP_OK;
+    }
+    esp_err_t ret = rmt_tx_wait_all_done(rmt_strip->rmt_chan, timeout_ms);
+    // all queued frames are out, leave the channel disabled as led_strip_refresh does
+    if (ret == ESP_OK && !rmt_strip->keep_enabled) {
+        ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+        rmt_strip->chan_enabled = false;
+    }
+    return ret;
+}
+
+static esp_err_t led_strip_rmt_register_refresh_done_cb(led_strip_t *strip, led_strip_refresh_done_cb_t cb, void *user_ctx)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    // make sure no frame completes while the callback and its context are half updated
+    ESP_RETURN_ON_ERROR(led_strip_rmt_wait_refresh_done(strip, -1), TAG, "flush RMT channel failed");
+    rmt_strip->on_refresh_done = NULL;
+    rmt_strip->user_ctx = user_ctx;
+    rmt_strip->on_refresh_done = cb;
+    return ESP_OK;
+}
+
+static esp_err_t led_strip_rmt_attach_framebuffer(led_strip_t *strip, uint8_t *frame_buf)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    uint8_t index = 0;
+
+    if (!frame_buf) {
+        // back to the internal buffers, whose content is whatever was there before the framebuffer was attached
+        rmt_strip->frame_bufs[0] = rmt_strip->pixel_bufs;
+        rmt_strip->frame_bufs[1] = rmt_strip->pixel_bufs + (rmt_strip->num_buffers - 1) * rmt_strip->strip_len * rmt_strip->bytes_per_pixel;
+        rmt_strip->external_fb = false;
+    } else {
+        // reuse the slot that tracks this buffer, otherwise the one whose last frame is older
+        if (rmt_strip->frame_bufs[0] == frame_buf) {
+            index = 0;
+        } else if (rmt_strip->frame_bufs[1] == frame_buf) {
+            index = 1;
+        } else {
+            index = (int32_t)(rmt_strip->buf_submit_seq[1] - rmt_strip->buf_submit_seq[0]) < 0 ? 1 : 0;
+        }
+        rmt_strip->frame_bufs[index] = frame_buf;
+        rmt_strip->external_fb = true;
+    }
+    rmt_strip->back_index = index;
+    rmt_strip->pixel_buf = rmt_strip->frame_bufs[index];
+    rmt_strip->back_needs_sync = false;
+    // the caller is about to render into the buffer, so no queued frame may still be reading it
+    return led_strip_rmt_wait_buffer(rmt_strip, index, -1);
+}
+
+static esp_err_t led_strip_rmt_clear(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    // Write zero to turn off all leds
+    ESP_RETURN_ON_ERROR(led_strip_rmt_acquire_back(rmt_strip), TAG, "acquire pixel buffer failed");
+    rmt_strip->back_needs_sync = false;
+    memset(rmt_strip->pixel_buf, 0, rmt_strip->strip_len * rmt_strip->bytes_per_pixel);
+    return led_strip_rmt_refresh(strip);
+}
+
+static esp_err_t led_strip_rmt_del(led_strip_t *strip)
+{
+    led_strip_rmt_obj *rmt_strip = __containerof(strip, led_strip_rmt_obj, base);
+    if (rmt_strip->chan_enabled) {
+        ESP_RETURN_ON_ERROR(rmt_tx_wait_all_done(rmt_strip->rmt_chan, -1), TAG, "flush RMT channel failed");
+        ESP_RETURN_ON_ERROR(rmt_disable(rmt_strip->rmt_chan), TAG, "disable RMT channel failed");
+    }
+    ESP_RETURN_ON_ERROR(rmt_del_channel(rmt_strip->rmt_chan), TAG, "delete RMT channel failed");
+    ESP_RETURN_ON_ERROR(rmt_del_encoder(rmt_strip->strip_encoder), TAG, "delete strip encoder failed");
+    vSemaphoreDelete(rmt_strip->done_sem);
+    free(rmt_strip);
+    return ESP_OK;
+}
+
+esp_err_t led_strip_new_rmt_device(const led_strip_config_t *led_config, const led_strip_rmt_config_t *rmt_config, led_strip_handle_t *ret_strip)
+{
+    led_strip_rmt_obj *rmt_strip = NULL;
+    esp_err_t ret = ESP_OK;
+    ESP_GOTO_ON_FALSE(led_config && rmt_config && ret_strip, ESP_ERR_INVALID_ARG, err, TAG, "invalid argument");
+    led_color_component_format_t component_fmt = led_config->color_component_format;
+    // If R/G/B order is not specified, set default GRB order as fallback
+    if (component_fmt.format_id == 0) {
+        component_fmt = LED_STRIP_COLOR_COMPONENT_FMT_GRB;
+    }
+    // check the validation of the color component format
+    uint8_t mask = 0;
+    if (component_fmt.format.num_components == 3) {
+        mask = BIT(component_fmt.format.r_pos) | BIT(component_fmt.format.g_pos) | BIT(component_fmt.format.b_pos);
+        // Check for invalid values
+        ESP_RETURN_ON_FALSE(mask == 0x07, ESP_ERR_INVALID_ARG, TAG, "invalid order argument");
+    } else if (component_fmt.format.num_components == 4) {
+        mask = BIT(component_fmt.format.r_pos) | BIT(component_fmt.format.g_pos) | BIT(component_fmt.format.b_pos) | BIT(component_fmt.format.w_pos);
+        // Check for invalid values
+        ESP_RETURN_ON_FALSE(mask == 0x0F, ESP_ERR_INVALID_ARG, TAG, "invalid order argument");
+    } else {
+        ESP_RETURN_ON_FALSE(false, ESP_ERR_INVALID_ARG, TAG, "invalid number of color components: %d", component_fmt.format.num_components);
+    }
+    // TODO: we assume each color component is 8 bits, may need to support other configurations in the future, e.g. 10bits per color component?
+    uint8_t bytes_per_pixel = component_fmt.format.num_components;
+    uint8_t num_buffers = rmt_config->flags.double_buffer ? 2 : 1;
+    rmt_strip = calloc(1, sizeof(led_strip_rmt_obj) + num_buffers * led_config->max_leds * bytes_per_pixel);
+    ESP_GOTO_ON_FALSE(rmt_strip, ESP_ERR_NO_MEM, err, TAG, "no mem for rmt strip");
+    rmt_strip->done_sem = xSemaphoreCreateBinary();
+    ESP_GOTO_ON_FALSE(rmt_strip->done_sem, ESP_ERR_NO_MEM, err, TAG, "no mem for done semaphore");
+    uint32_t resolution = rmt_config->resolution_hz ? rmt_config->resolution_hz : LED_STRIP_RMT_DEFAULT_RESOLUTION;
+
+    // for backward compatibility, if the user does not set the clk_src, use the default value
+    rmt_clock_source_t clk_src = RMT_CLK_SRC_DEFAULT;
+    if (rmt_config->clk_src) {
+        clk_src = rmt_config->clk_src;
+    }
+    size_t mem_block_symbols = LED_STRIP_RMT_DEFAULT_MEM_BLOCK_SYMBOLS;
+    // override the default value if the user sets it
+    if (rmt_config->mem_block_symbols) {
+        mem_block_symbols = rmt_config->mem_block_symbols;
+    }
+    rmt_tx_channel_config_t rmt_chan_config = {
+        .clk_src = clk_src,
+        .gpio_num = led_config->strip_gpio_num,
+        .mem_block_symbols = mem_block_symbols,
+        .resolution_hz = resolution,
+        .trans_queue_depth = LED_STRIP_RMT_DEFAULT_TRANS_QUEUE_SIZE,
+        .flags.with_dma = rmt_config->flags.with_dma,
+        .flags.invert_out = led_config->flags.invert_out,
+    };
+    ESP_GOTO_ON_ERROR(rmt_new_tx_channel(&rmt_chan_config, &rmt_strip->rmt_chan), err, TAG, "create RMT TX channel failed");
+
+    led_strip_encoder_config_t strip_encoder_conf = {
+        .resolution = resolution,
+        .led_model = led_config->led_model
+    };
+    ESP_GOTO_ON_ERROR(rmt_new_led_strip_encoder(&strip_encoder_conf, &rmt_strip->strip_encoder), err, TAG, "create LED strip encoder failed");
+
+    rmt_tx_event_callbacks_t cbs = {
+        .on_trans_done = led_strip_rmt_trans_done_cb,
+    };
+    ESP_GOTO_ON_ERROR(rmt_tx_register_event_callbacks(rmt_strip->rmt_chan, &cbs, rmt_strip), err, TAG, "register RMT callbacks failed");
+    if (rmt_config->flags.keep_enabled) {
+        // pay for the channel power up (and the power management lock) once, not on every refresh
+        ESP_GOTO_ON_ERROR(rmt_enable(rmt_strip->rmt_chan), err, TAG, "enable RMT channel failed");
+        rmt_strip->chan_enabled = true;
+        rmt_strip->keep_enabled = true;
+    }
+
+    rmt_strip->component_fmt = component_fmt;
+    rmt_strip->bytes_per_pixel = bytes_per_pixel;
+    rmt_strip->strip_len = led_config->max_leds;
+    rmt_strip->num_buffers = num_buffers;
+    rmt_strip->frame_bufs[0] = rmt_strip->pixel_bufs;
+    rmt_strip->frame_bufs[1] = rmt_strip->pixel_bufs + (num_buffers - 1) * led_config->max_leds * bytes_per_pixel;
+    rmt_strip->pixel_buf = rmt_strip->frame_bufs[0];
+    rmt_strip->base.set_pixel = led_strip_rmt_set_pixel;
+    rmt_strip->base.set_pixel_rgbw = led_strip_rmt_set_pixel_rgbw;
+    rmt_strip->base.set_pixels = led_strip_rmt_set_pixels;
+    rmt_strip->base.refresh = led_strip_rmt_refresh;
+    rmt_strip->base.refresh_async = led_strip_rmt_refresh_async;
+    rmt_strip->base.wait_refresh_done = led_strip_rmt_wait_refresh_done;
+    rmt_strip->base.register_refresh_done_cb = led_strip_rmt_register_refresh_done_cb;
+    rmt_strip->base.attach_framebuffer = led_strip_rmt_attach_framebuffer;
+    rmt_strip->base.clear = led_strip_rmt_clear;
+    rmt_strip->base.del = led_strip_rmt_del;
+
+    *ret_strip = &rmt_strip->base;
+    return ESP_OK;
+err:
+    if (rmt_strip) {
+        if (rmt_strip->rmt_chan) {
+            rmt_del_channel(rmt_strip->rmt_chan);
+        }
+        if (rmt_strip->strip_encoder) {
+            rmt_del_encoder(rmt_strip->strip_encoder);
+        }
+        if (rmt_strip->done_sem) {
+            vSemaphoreDelete(rmt_strip->done_sem);
+        }
+        free(rmt_strip);
+    }
+    return ret;
+}
@@ -12,13 +12,11 @@
 #include "soc/spi_periph.h"
 #include "led_strip.h"
 #include "led_strip_interface.h"
+#include "led_strip_spi_encoder.h"
 
 #define LED_STRIP_SPI_DEFAULT_RESOLUTION (2.5 * 1000 * 1000) // 2.5MHz resolution
 #define LED_STRIP_SPI_DEFAULT_TRANS_QUEUE_SIZE 4
 
-#define SPI_BYTES_PER_COLOR_BYTE 3
-#define SPI_BITS_PER_COLOR_BYTE (SPI_BYTES_PER_COLOR_BYTE * 8)
-
 static const char *TAG = "led_strip_spi";
 
 typedef struct {
@@ -31,22 +29,6 @@ typedef struct {
     uint8_t pixel_buf[];
 } led_strip_spi_obj;
 
-// please make sure to zero-initialize the buf before calling this function
-static void __led_strip_spi_bit(uint8_t data, uint8_t *buf)
-{
-    // Each color of 1 bit is represented by 3 bits of SPI, low_level:100 ,high_level:110
-    // So a color byte occupies 3 bytes of SPI.
-    *(buf + 2) |= data & BIT(0) ? BIT(2) | BIT(1) : BIT(2);
-    *(buf + 2) |= data & BIT(1) ? BIT(5) | BIT(4) : BIT(5);
-    *(buf + 2) |= data & BIT(2) ? BIT(7) : 0x00;
-    *(buf + 1) |= BIT(0);
-    *(buf + 1) |= data & BIT(3) ? BIT(3) | BIT(2) : BIT(3);
-    *(buf + 1) |= data & BIT(4) ? BIT(6) | BIT(5) : BIT(6);
-    *(buf + 0) |= data & BIT(5) ? BIT(1) | BIT(0) : BIT(1);
-    *(buf + 0) |= data & BIT(6) ? BIT(4) | BIT(3) : BIT(4);
-    *(buf + 0) |= data & BIT(7) ? BIT(7) | BIT(6) : BIT(7);
-}
-
 static esp_err_t led_strip_spi_set_pixel(led_strip_t *strip, uint32_t index, uint32_t red, uint32_t green, uint32_t blue)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
@@ -55,7 +37,6 @@ static esp_err_t led_strip_spi_set_pixel(led_strip_t *strip, uint32_t index, uin
     uint32_t start = index * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
     uint8_t *pixel_buf = spi_strip->pixel_buf;
     led_color_component_format_t component_fmt = spi_strip->component_fmt;
-    memset(pixel_buf + start, 0, spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
 
     __led_strip_spi_bit(red, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.r_pos]);
     __led_strip_spi_bit(green, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.g_pos]);
@@ -77,7 +58,6 @@ static esp_err_t led_strip_spi_set_pixel_rgbw(led_strip_t *strip, uint32_t index
     // LED_PIXEL_FORMAT_GRBW takes 96bits(12bytes)
     uint32_t start = index * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
     uint8_t *pixel_buf = spi_strip->pixel_buf;
-    memset(pixel_buf + start, 0, spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
 
     __led_strip_spi_bit(red, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.r_pos]);
     __led_strip_spi_bit(green, &pixel_buf[start + SPI_BYTES_PER_COLOR_BYTE * component_fmt.format.g_pos]);
@@ -87,6 +67,44 @@ static esp_err_t led_strip_spi_set_pixel_rgbw(led_strip_t *strip, uint32_t index
     return ESP_OK;
 }
 
+static esp_err_t led_strip_spi_set_pixels(led_strip_t *strip, uint32_t start, uint32_t count, const uint8_t *pixels, led_color_component_format_t format)
+{
+    led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
+    ESP_RETURN_ON_FALSE(start <= spi_strip->strip_len && count <= spi_strip->strip_len - start, ESP_ERR_INVALID_ARG, TAG, "pixels out of maximum number of LEDs");
+
+    led_color_component_format_t component_fmt = spi_strip->component_fmt;
+    uint8_t bytes_per_pixel = spi_strip->bytes_per_pixel;
+    uint8_t src_bytes_per_pixel = format.format.num_components;
+    uint8_t *pixel_buf = spi_strip->pixel_buf + start * bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+
+    if (src_bytes_per_pixel == bytes_per_pixel && format.format.r_pos == component_fmt.format.r_pos &&
+            format.format.g_pos == component_fmt.format.g_pos && format.format.b_pos == component_fmt.format.b_pos &&
+            (bytes_per_pixel == 3 || format.format.w_pos == component_fmt.format.w_pos)) {
+        // the source is already in the wire order of the strip, encode it byte by byte
+        for (uint32_t i = 0; i < count * bytes_per_pixel; i++) {
+            __led_strip_spi_bit(pixels[i], pixel_buf);
+            pixel_buf += SPI_BYTES_PER_COLOR_BYTE;
+        }
+        return ESP_OK;
+    }
+
+    uint8_t r_pos = component_fmt.format.r_pos * SPI_BYTES_PER_COLOR_BYTE, src_r_pos = format.format.r_pos;
+    uint8_t g_pos = component_fmt.format.g_pos * SPI_BYTES_PER_COLOR_BYTE, src_g_pos = format.format.g_pos;
+    uint8_t b_pos = component_fmt.format.b_pos * SPI_BYTES_PER_COLOR_BYTE, src_b_pos = format.format.b_pos;
+    uint8_t w_pos = component_fmt.format.w_pos * SPI_BYTES_PER_COLOR_BYTE, src_w_pos = format.format.w_pos;
+    for (uint32_t i = 0; i < count; i++) {
+        __led_strip_spi_bit(pixels[src_r_pos], &pixel_buf[r_pos]);
+        __led_strip_spi_bit(pixels[src_g_pos], &pixel_buf[g_pos]);
+        __led_strip_spi_bit(pixels[src_b_pos], &pixel_buf[b_pos]);
+        if (bytes_per_pixel > 3) {
+            __led_strip_spi_bit(src_bytes_per_pixel > 3 ? pixels[src_w_pos] : 0, &pixel_buf[w_pos]);
+        }
+        pixel_buf += bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE;
+        pixels += src_bytes_per_pixel;
+    }
+    return ESP_OK;
+}
+
 static esp_err_t led_strip_spi_refresh(led_strip_t *strip)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
@@ -105,12 +123,7 @@ static esp_err_t led_strip_spi_clear(led_strip_t *strip)
 {
     led_strip_spi_obj *spi_strip = __containerof(strip, led_strip_spi_obj, base);
     //Write zero to turn off all leds
-    memset(spi_strip->pixel_buf, 0, spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
-    uint8_t *buf = spi_strip->pixel_buf;
-    for (int index = 0; index < spi_strip->strip_len * spi_strip->bytes_per_pixel; index++) {
-        __led_strip_spi_bit(0, buf);
-        buf += SPI_BYTES_PER_COLOR_BYTE;
-    }
+    __led_strip_spi_fill_off(spi_strip->pixel_buf, spi_strip->strip_len * spi_strip->bytes_per_pixel * SPI_BYTES_PER_COLOR_BYTE);
 
     return led_strip_spi_refresh(strip);
 }
@@ -210,6 +223,7 @@ esp_err_t led_strip_new_spi_device(const led_strip_config_t *led_config, const l
     spi_strip->strip_len = led_config->max_leds;
     spi_strip->base.set_pixel = led_strip_spi_set_pixel;
     spi_strip->base.set_pixel_rgbw = led_strip_spi_set_pixel_rgbw;
+    spi_strip->base.set_pixels = led_strip_spi_set_pixels;
     spi_strip->base.refresh = led_strip_spi_refresh;
     spi_strip->base.clear = led_strip_spi_clear;
     spi_strip->base.del = led_strip_spi_del;
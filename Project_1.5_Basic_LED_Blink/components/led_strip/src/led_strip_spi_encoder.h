@@ -0,0 +1,63 @@
+/*
+ * SPDX-FileCopyrightText: 2022-2024 Espressif Systems (Shanghai) CO LTD
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define SPI_BYTES_PER_COLOR_BYTE 3
+#define SPI_BITS_PER_COLOR_BYTE (SPI_BYTES_PER_COLOR_BYTE * 8)
+
+// Each color of 1 bit is represented by 3 bits of SPI, low_level:100 ,high_level:110
+// So a color nibble occupies 12 bits of SPI, and a color byte occupies 3 bytes of SPI.
+static const uint16_t s_spi_nibble_pattern[16] = {
+    0x924, 0x926, 0x934, 0x936, 0x9A4, 0x9A6, 0x9B4, 0x9B6,
+    0xD24, 0xD26, 0xD34, 0xD36, 0xDA4, 0xDA6, 0xDB4, 0xDB6,
+};
+
+/**
+ * @brief Encode one color byte into the 3 SPI bytes that carry it
+ *
+ * @param data Color byte
+ * @param buf Destination, SPI_BYTES_PER_COLOR_BYTE bytes are overwritten
+ */
+static inline void __led_strip_spi_bit(uint8_t data, uint8_t *buf)
+{
+    uint32_t pattern = ((uint32_t)s_spi_nibble_pattern[data >> 4] << 12) | s_spi_nibble_pattern[data & 0x0F];
+    buf[0] = (pattern >> 16) & 0xFF;
+    buf[1] = (pattern >> 8) & 0xFF;
+    buf[2] = pattern & 0xFF;
+}
+
+/**
+ * @brief Fill a SPI pixel buffer with the encoding of color 0 (all LEDs off)
+ *
+ * @param buf SPI pixel buffer
+ * @param size Buffer size in bytes, a multiple of SPI_BYTES_PER_COLOR_BYTE
+ */
+static inline void __led_strip_spi_fill_off(uint8_t *buf, size_t size)
+{
+    size_t filled = 0;
+    if (size) {
+        __led_strip_spi_bit(0, buf);
+        filled = SPI_BYTES_PER_COLOR_BYTE;
+    }
+    // every color byte encodes to the same pattern, so keep doubling the filled part
+    while (filled < size) {
+        size_t chunk = filled < size - filled ? filled : size - filled;
+        memcpy(buf + filled, buf, chunk);
+        filled += chunk;
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
@@ -16,7 +16,11 @@ void app_main(void) // Función principal requerida por ESP-IDF
         .timer_sel = LEDC_TIMER_0 // Temporizador LEDC seleccionado
     }; // Fin de la inicialización de my_led
 
-    rgb_led_init(&my_led); // Configurar hardware PWM y canales para el LED
+    ESP_ERROR_CHECK(rgb_led_init(&my_led)); // Configurar hardware PWM, canales y mutex del LED
+
+#if RGB_LED_BENCHMARK // Sólo con el benchmark activado
+    rgb_led_benchmark(&my_led); // Comparar canal a canal frente a commit
+#endif // RGB_LED_BENCHMARK
 
     while (1) { // Bucle principal infinito
         rgb_led_set_color(&my_led, 255, 0, 0);  // Encender rojo al máximo
@@ -1,4 +1,24 @@
 #include "rgb_led.h" // Cabecera con tipos y prototipos para el LED RGB
+#include "freertos/timers.h" // xTimerPendFunctionCallFromISR para diferir desde ISR
+#include "esp_attr.h" // IRAM_ATTR para la variante de ISR
+
+#if RGB_LED_BENCHMARK // Instrumentación sólo con el benchmark activado
+#include "esp_cpu.h" // Contador de ciclos de la CPU
+#include "esp_log.h" // Salida de resultados
+#include "sdkconfig.h" // Frecuencia de la CPU
+static uint32_t driver_calls = 0; // Llamadas al driver LEDC contabilizadas
+static uint32_t first_latch = 0; // Ciclo del primer enclavado de un color
+static uint32_t last_latch = 0; // Ciclo del último enclavado de un color
+#define LEDC_CALL(expr) (driver_calls++, (expr)) // Contar cada llamada al driver
+#define LATCH_MARK_FIRST() (first_latch = esp_cpu_get_cycle_count()) // Marcar primer enclavado
+#define LATCH_MARK_LAST() (last_latch = esp_cpu_get_cycle_count()) // Marcar último enclavado
+#else // Sin benchmark las macros no añaden código
+#define LEDC_CALL(expr) (expr) // Llamada directa al driver
+#define LATCH_MARK_FIRST() ((void)0) // Sin instrumentación
+#define LATCH_MARK_LAST() ((void)0) // Sin instrumentación
+#endif // RGB_LED_BENCHMARK
+
+static portMUX_TYPE latch_lock = portMUX_INITIALIZER_UNLOCKED; // Spinlock del enclavado conjunto
 
 esp_err_t rgb_led_init(rgb_led_t *led) // Inicializa temporizador y canales LEDC
 { // Inicio de rgb_led_init
@@ -43,20 +63,146 @@ esp_err_t rgb_led_init(rgb_led_t *led) // Inicializa temporizador y canales LEDC
         ESP_ERROR_CHECK(ledc_channel_config(&channels[i])); // Configurar cada canal
     } // Fin del bucle de configuración
 
+    led->lock = xSemaphoreCreateMutex(); // Mutex que serializa las escrituras de duty
+    if (led->lock == NULL) { // Sin memoria para el mutex
+        return ESP_ERR_NO_MEM; // Informar del fallo
+    } // Fin de la comprobación del mutex
+
     return ESP_OK; // Devolver éxito
 } // Fin de rgb_led_init
 
-esp_err_t rgb_led_set_color(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b) // Ajusta RGB
-{ // Inicio de rgb_led_set_color
+void rgb_led_stage_color(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b) // Prepara RGB
+{ // Inicio de rgb_led_stage_color
     // Como es cátodo común, un valor mayor en duty = más brillo
-    ESP_ERROR_CHECK(ledc_set_duty(led->speed_mode, led->channel_r, r)); // Fijar duty rojo
-    ESP_ERROR_CHECK(ledc_update_duty(led->speed_mode, led->channel_r)); // Aplicar duty rojo
+    xSemaphoreTake(led->lock, portMAX_DELAY); // Proteger los tres valores frente a otro escritor
+    led->staged_r = r; // Guardar duty rojo
+    led->staged_g = g; // Guardar duty verde
+    led->staged_b = b; // Guardar duty azul
+    xSemaphoreGive(led->lock); // Liberar el LED
+} // Fin de rgb_led_stage_color
 
-    ESP_ERROR_CHECK(ledc_set_duty(led->speed_mode, led->channel_g, g)); // Fijar duty verde
-    ESP_ERROR_CHECK(ledc_update_duty(led->speed_mode, led->channel_g)); // Aplicar duty verde
+// Carga y enclava los duty preparados; quien llama ya tiene led->lock
+static esp_err_t rgb_led_commit_locked(rgb_led_t *led) // Núcleo común de commit y set_color
+{ // Inicio de rgb_led_commit_locked
+    esp_err_t err = ESP_OK; // Resultado de la carga de registros
 
-    ESP_ERROR_CHECK(ledc_set_duty(led->speed_mode, led->channel_b, b)); // Fijar duty azul
-    ESP_ERROR_CHECK(ledc_update_duty(led->speed_mode, led->channel_b)); // Aplicar duty azul
+    // ledc_set_duty sólo carga el registro; el canal sigue con el duty anterior
+    err = LEDC_CALL(ledc_set_duty(led->speed_mode, led->channel_r, led->staged_r)); // Cargar duty rojo
+    if (err == ESP_OK) { // Continuar sólo si el rojo se cargó
+        err = LEDC_CALL(ledc_set_duty(led->speed_mode, led->channel_g, led->staged_g)); // Cargar duty verde
+    } // Fin de la carga del verde
+    if (err == ESP_OK) { // Continuar sólo si el verde se cargó
+        err = LEDC_CALL(ledc_set_duty(led->speed_mode, led->channel_b, led->staged_b)); // Cargar duty azul
+    } // Fin de la carga del azul
+    if (err == ESP_OK) { // Enclavar sólo si los tres registros están cargados
+        // Las tres actualizaciones seguidas y sin interrupciones: cada canal aplica su duty en el
+        // siguiente desbordamiento del timer compartido, y si éste cae entre dos update_duty
+        // un único periodo PWM (200 us) mezcla el color anterior y el nuevo
+        taskENTER_CRITICAL(&latch_lock); // Inicio de la sección crítica
+        LATCH_MARK_FIRST(); // Instante del primer enclavado
+        LEDC_CALL(ledc_update_duty(led->speed_mode, led->channel_r)); // Enclavar rojo
+        LEDC_CALL(ledc_update_duty(led->speed_mode, led->channel_g)); // Enclavar verde
+        LEDC_CALL(ledc_update_duty(led->speed_mode, led->channel_b)); // Enclavar azul
+        LATCH_MARK_LAST(); // Instante del último enclavado
+        taskEXIT_CRITICAL(&latch_lock); // Fin de la sección crítica
+    } // Fin del enclavado conjunto
 
-    return ESP_OK; // Devolver éxito
+    return err; // Devolver el resultado de la carga
+} // Fin de rgb_led_commit_locked
+
+esp_err_t rgb_led_commit(rgb_led_t *led) // Aplica los duty preparados
+{ // Inicio de rgb_led_commit
+    xSemaphoreTake(led->lock, portMAX_DELAY); // Otra tarea no puede intercalar sus canales
+    esp_err_t err = rgb_led_commit_locked(led); // Cargar y enclavar
+    xSemaphoreGive(led->lock); // Liberar el LED para otros escritores
+    return err; // Devolver el resultado de la carga
+} // Fin de rgb_led_commit
+
+esp_err_t rgb_led_set_color(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b) // Ajusta RGB
+{ // Inicio de rgb_led_set_color
+    // Preparar y aplicar bajo el mismo mutex: otra tarea no puede cambiar los
+    // valores preparados entre ambos pasos y enclavar un color mezclado
+    xSemaphoreTake(led->lock, portMAX_DELAY); // Tomar el LED una sola vez
+    led->staged_r = r; // Guardar duty rojo
+    led->staged_g = g; // Guardar duty verde
+    led->staged_b = b; // Guardar duty azul
+    esp_err_t err = rgb_led_commit_locked(led); // Cargar y enclavar los tres
+    xSemaphoreGive(led->lock); // Liberar el LED
+    return err; // Devolver el resultado de la carga
 } // Fin de rgb_led_set_color
+
+static void rgb_led_deferred_set(void *arg, uint32_t packed_rgb) // Se ejecuta en la tarea de temporizadores
+{ // Inicio de rgb_led_deferred_set
+    rgb_led_set_color((rgb_led_t *)arg, (packed_rgb >> 16) & 0xFF, // Rojo en los bits 16..23
+                      (packed_rgb >> 8) & 0xFF, packed_rgb & 0xFF); // Verde en 8..15 y azul en 0..7
+} // Fin de rgb_led_deferred_set
+
+esp_err_t IRAM_ATTR rgb_led_set_color_from_isr(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b, // Ajusta RGB desde ISR
+                                               BaseType_t *higher_priority_task_woken) // Indica si hay que ceder la CPU
+{ // Inicio de rgb_led_set_color_from_isr
+    // El mutex no se puede tomar en una ISR: se difiere la escritura. En IRAM para poder
+    // llamarla desde ISR con ESP_INTR_FLAG_IRAM, activas aunque la caché flash esté desactivada
+    uint32_t packed_rgb = ((uint32_t)r << 16) | ((uint32_t)g << 8) | b; // Empaquetar el color en 24 bits
+    if (xTimerPendFunctionCallFromISR(rgb_led_deferred_set, led, packed_rgb, // Encolar la escritura
+                                      higher_priority_task_woken) != pdPASS) { // Cola de temporizadores llena
+        return ESP_ERR_TIMEOUT; // El color no se aplicará
+    } // Fin de la comprobación del encolado
+    return ESP_OK; // Escritura encolada
+} // Fin de rgb_led_set_color_from_isr
+
+#if RGB_LED_BENCHMARK // Sólo con el benchmark activado
+#define RGB_LED_BENCH_ITERATIONS 100 // Colores aplicados por cada camino
+
+// Camino original (antes de serializar y agrupar): set_duty + update_duty por canal,
+// 6 llamadas al driver con cada canal enclavado en cuanto se fija
+static void rgb_led_set_color_per_channel(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b) // Canal a canal
+{ // Inicio de rgb_led_set_color_per_channel
+    xSemaphoreTake(led->lock, portMAX_DELAY); // Mismo mutex que el commit, para comparar en igualdad
+    LATCH_MARK_FIRST(); // Instante previo al primer canal
+    LEDC_CALL(ledc_set_duty(led->speed_mode, led->channel_r, r)); // Fijar duty rojo
+    LEDC_CALL(ledc_update_duty(led->speed_mode, led->channel_r)); // Aplicar duty rojo
+    LEDC_CALL(ledc_set_duty(led->speed_mode, led->channel_g, g)); // Fijar duty verde
+    LEDC_CALL(ledc_update_duty(led->speed_mode, led->channel_g)); // Aplicar duty verde
+    LEDC_CALL(ledc_set_duty(led->speed_mode, led->channel_b, b)); // Fijar duty azul
+    LEDC_CALL(ledc_update_duty(led->speed_mode, led->channel_b)); // Aplicar duty azul
+    LATCH_MARK_LAST(); // Instante tras el último canal
+    xSemaphoreGive(led->lock); // Liberar el LED
+} // Fin de rgb_led_set_color_per_channel
+
+void rgb_led_benchmark(rgb_led_t *led) // Compara ambos caminos
+{ // Inicio de rgb_led_benchmark
+    const char *TAG = "RGB_LED_BENCH"; // Etiqueta de log
+    uint32_t cycles_per_us = CONFIG_ESP_DEFAULT_CPU_FREQ_MHZ; // Ciclos por microsegundo
+    uint32_t max_skew[2] = {0, 0}; // Peor desfase por camino (ciclos)
+    uint64_t sum_skew[2] = {0, 0}; // Desfase acumulado por camino (ciclos)
+    uint32_t calls[2] = {0, 0}; // Llamadas al driver por camino
+
+    // Ambos caminos hacen 6 llamadas por color (3 set_duty + 3 update_duty): la
+    // diferencia está en el desfase entre el primer y el último enclavado
+    for (int path = 0; path < 2; path++) { // 0: canal a canal, 1: commit
+        driver_calls = 0; // Reiniciar el contador de llamadas
+        for (int i = 0; i < RGB_LED_BENCH_ITERATIONS; i++) { // Alternar colores
+            uint8_t level = (i & 1) ? 255 : 0; // Cambiar los tres canales en cada iteración
+            if (path == 0) { // Camino original
+                rgb_led_set_color_per_channel(led, level, 255 - level, level); // Canal a canal
+            } else { // Camino nuevo
+                rgb_led_set_color(led, level, 255 - level, level); // Preparar y enclavar juntos
+            } // Fin de la selección de camino
+            uint32_t skew = last_latch - first_latch; // Desfase entre primer y último enclavado
+            sum_skew[path] += skew; // Acumular para la media
+            if (skew > max_skew[path]) { // Nuevo peor caso
+                max_skew[path] = skew; // Guardarlo
+            } // Fin de la comprobación del máximo
+        } // Fin de las iteraciones
+        calls[path] = driver_calls; // Guardar las llamadas del camino
+    } // Fin de los caminos
+
+    for (int path = 0; path < 2; path++) { // Informar de cada camino
+        ESP_LOGI(TAG, "%s: %lu llamadas/color, desfase medio %lu us, máximo %lu us (periodo PWM 200 us)", // Resultado
+                 path == 0 ? "Canal a canal" : "Commit", // Nombre del camino
+                 (unsigned long)(calls[path] / RGB_LED_BENCH_ITERATIONS), // Llamadas por color
+                 (unsigned long)(sum_skew[path] / RGB_LED_BENCH_ITERATIONS / cycles_per_us), // Desfase medio
+                 (unsigned long)(max_skew[path] / cycles_per_us)); // Desfase máximo
+    } // Fin del informe
+} // Fin de rgb_led_benchmark
+#endif // RGB_LED_BENCHMARK
@@ -3,6 +3,12 @@
 
 #include "driver/ledc.h" // Controlador LEDC (PWM) de ESP-IDF
 #include "esp_err.h" // Tipos de error de ESP-IDF
+#include "freertos/FreeRTOS.h" // API base de FreeRTOS
+#include "freertos/semphr.h" // Mutex para serializar escrituras de duty
+
+#ifndef RGB_LED_BENCHMARK // Interruptor de compilación del benchmark
+#define RGB_LED_BENCHMARK 0 // 1: compilar rgb_led_benchmark()
+#endif // RGB_LED_BENCHMARK
 
 // Estructura para manejar un LED RGB
 typedef struct { // Definición de rgb_led_t
@@ -14,12 +20,35 @@ typedef struct { // Definición de rgb_led_t
     ledc_channel_t channel_b; // Canal LEDC para azul
     ledc_mode_t speed_mode; // Modo de velocidad (high/low)
     ledc_timer_t timer_sel; // Temporizador LEDC seleccionado
+    SemaphoreHandle_t lock; // Mutex creado en rgb_led_init (no inicializar a mano)
+    uint8_t staged_r; // Duty rojo preparado para el próximo commit
+    uint8_t staged_g; // Duty verde preparado para el próximo commit
+    uint8_t staged_b; // Duty azul preparado para el próximo commit
 } rgb_led_t; // Tipo de dato para representar el LED RGB
 
 // Inicializa el LED RGB con PWM
 esp_err_t rgb_led_init(rgb_led_t *led); // Prototipo: configurar timers y canales
 
 // Ajusta el color (0-255 por componente)
+// Prepara un color sin tocar el hardware
+void rgb_led_stage_color(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b); // Prototipo: preparar duty
+
+// Carga los tres duty preparados y los enclava seguidos en una sección crítica;
+// si el timer desborda entre dos canales, como mucho un periodo PWM mezcla colores
+esp_err_t rgb_led_commit(rgb_led_t *led); // Prototipo: aplicar duty preparados
+
+// Seguro entre tareas: prepara y aplica el color bajo una única toma del mutex
 esp_err_t rgb_led_set_color(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b); // Prototipo: fijar duty
 
+// Variante para ISR: difiere la escritura a la tarea de temporizadores de FreeRTOS.
+// Está en IRAM, así que también vale para ISR registradas con ESP_INTR_FLAG_IRAM
+esp_err_t rgb_led_set_color_from_isr(rgb_led_t *led, uint8_t r, uint8_t g, uint8_t b,
+                                     BaseType_t *higher_priority_task_woken); // Prototipo: fijar duty desde ISR
+
+#if RGB_LED_BENCHMARK // Sólo con el benchmark activado
+// Compara llamadas al driver y desfase de enclavado entre la secuencia original
+// canal a canal (set_duty + update_duty por canal) y commit
+void rgb_led_benchmark(rgb_led_t *led); // Prototipo: medir ambos caminos
+#endif // RGB_LED_BENCHMARK
+
 #endif // RGB_LED_H - fin del guard de inclusión
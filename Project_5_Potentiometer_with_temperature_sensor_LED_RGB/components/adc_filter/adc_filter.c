@@ -0,0 +1,102 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "adc_filter.h"
+#include <string.h>
+
+// ===== MEDIA MÓVIL =====
+void adc_filter_ma_init(adc_filter_ma_t *f, uint8_t window)
+{
+    memset(f, 0, sizeof(*f));
+    if (window == 0) window = 1;
+    if (window > ADC_FILTER_MA_MAX_WINDOW) window = ADC_FILTER_MA_MAX_WINDOW;
+    f->window = window;
+}
+
+uint32_t adc_filter_ma_update(adc_filter_ma_t *f, uint32_t sample)
+{
+    // Sólo se resta la muestra que sale de la ventana: coste constante
+    f->sum -= f->samples[f->index];
+    f->samples[f->index] = (uint16_t)sample;
+    f->sum += (uint16_t)sample;
+    f->index = (uint8_t)((f->index + 1) % f->window);
+    if (f->count < f->window) {
+        f->count++;
+    }
+    return f->sum / f->count;
+}
+
+// ===== IIR DE UN POLO =====
+void adc_filter_iir_init(adc_filter_iir_t *f, uint8_t shift)
+{
+    f->state = 0;
+    f->shift = shift > 15 ? 15 : shift;
+    f->primed = false;
+}
+
+uint32_t adc_filter_iir_update(adc_filter_iir_t *f, uint32_t sample)
+{
+    int32_t x = (int32_t)(sample << 16);
+
+    // La primera muestra inicializa el estado para evitar el transitorio desde 0
+    if (!f->primed) {
+        f->state = x;
+        f->primed = true;
+    } else {
+        f->state += (x - f->state) >> f->shift;
+    }
+    return (uint32_t)((f->state + (1 << 15)) >> 16);
+}
+
+// ===== MEDIANA =====
+void adc_filter_median_init(adc_filter_median_t *f, uint8_t window)
+{
+    memset(f, 0, sizeof(*f));
+    if (window < 3) window = 3;
+    if (window > ADC_FILTER_MEDIAN_MAX_WINDOW) window = ADC_FILTER_MEDIAN_MAX_WINDOW;
+    f->window = window | 1;
+    if (f->window > ADC_FILTER_MEDIAN_MAX_WINDOW) f->window -= 2;
+}
+
+uint32_t adc_filter_median_update(adc_filter_median_t *f, uint32_t sample)
+{
+    uint16_t sorted[ADC_FILTER_MEDIAN_MAX_WINDOW];
+
+    f->samples[f->index] = (uint16_t)sample;
+    f->index = (uint8_t)((f->index + 1) % f->window);
+    if (f->count < f->window) {
+        f->count++;
+    }
+
+    // Ordenación por inserción de como mucho ADC_FILTER_MEDIAN_MAX_WINDOW elementos
+    for (uint8_t i = 0; i < f->count; i++) {
+        uint16_t value = f->samples[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > value) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = value;
+    }
+    return sorted[f->count / 2];
+}
+
+// ===== BANDA MUERTA =====
+void adc_filter_deadband_init(adc_filter_deadband_t *f, uint32_t deadband, uint32_t full_scale)
+{
+    f->output = 0;
+    f->deadband = deadband;
+    f->full_scale = full_scale;
+    f->primed = false;
+}
+
+uint32_t adc_filter_deadband_update(adc_filter_deadband_t *f, uint32_t sample)
+{
+    uint32_t distance = sample > f->output ? sample - f->output : f->output - sample;
+
+    bool at_rail = sample == 0 || sample >= f->full_scale;
+
+    if (!f->primed || distance > f->deadband || at_rail) {
+        f->output = sample;
+        f->primed = true;
+    }
+    return f->output;
+}
@@ -0,0 +1,61 @@
+#ifndef ADC_FILTER_H
+#define ADC_FILTER_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Filtros enteros para canales ADC. Cada filtro guarda su estado en la propia
+// estructura (sin memoria dinámica) y procesa cada muestra en tiempo acotado.
+
+// ===== MEDIA MÓVIL (suma acumulada) =====
+#define ADC_FILTER_MA_MAX_WINDOW        32
+
+typedef struct {
+    uint16_t samples[ADC_FILTER_MA_MAX_WINDOW];
+    uint32_t sum;
+    uint8_t window;
+    uint8_t index;
+    uint8_t count;
+} adc_filter_ma_t;
+
+void adc_filter_ma_init(adc_filter_ma_t *f, uint8_t window);
+uint32_t adc_filter_ma_update(adc_filter_ma_t *f, uint32_t sample);
+
+// ===== IIR DE UN POLO: y += (x - y) / 2^shift =====
+typedef struct {
+    int32_t state;              // Salida en Q16.16 para no perder resolución
+    uint8_t shift;
+    bool primed;
+} adc_filter_iir_t;
+
+void adc_filter_iir_init(adc_filter_iir_t *f, uint8_t shift);
+uint32_t adc_filter_iir_update(adc_filter_iir_t *f, uint32_t sample);
+
+// ===== MEDIANA DE VENTANA PEQUEÑA (rechazo de picos) =====
+#define ADC_FILTER_MEDIAN_MAX_WINDOW    7
+
+typedef struct {
+    uint16_t samples[ADC_FILTER_MEDIAN_MAX_WINDOW];
+    uint8_t window;             // Impar, 3..ADC_FILTER_MEDIAN_MAX_WINDOW
+    uint8_t index;
+    uint8_t count;
+} adc_filter_median_t;
+
+void adc_filter_median_init(adc_filter_median_t *f, uint8_t window);
+uint32_t adc_filter_median_update(adc_filter_median_t *f, uint32_t sample);
+
+// ===== BANDA MUERTA / HISTÉRESIS =====
+// La salida sólo sigue a la entrada cuando ésta se aleja más de 'deadband', o
+// cuando llega a 0 o a 'full_scale': sin esto la salida podía quedarse hasta
+// 'deadband' cuentas antes de los extremos (el IIR se acerca en pasos pequeños)
+typedef struct {
+    uint32_t output;
+    uint32_t deadband;
+    uint32_t full_scale;
+    bool primed;
+} adc_filter_deadband_t;
+
+void adc_filter_deadband_init(adc_filter_deadband_t *f, uint32_t deadband, uint32_t full_scale);
+uint32_t adc_filter_deadband_update(adc_filter_deadband_t *f, uint32_t sample);
+
+#endif // ADC_FILTER_H
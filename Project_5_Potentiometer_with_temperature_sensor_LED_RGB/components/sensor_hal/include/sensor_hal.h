@@ -0,0 +1,74 @@
+#ifndef SENSOR_HAL_H
+#define SENSOR_HAL_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_adc/adc_oneshot.h"
+#include "esp_adc/adc_cali.h"
+
+// Capa común de acceso al ADC: cada unidad oneshot y cada esquema de
+// calibración (unidad, atenuación) se crean una sola vez y se comparten entre
+// todos los sensores registrados. Las funciones de registro se llaman durante
+// la inicialización, antes de crear las tareas que leen los canales.
+
+#define SENSOR_HAL_MAX_CHANNELS     8
+#define SENSOR_HAL_RAW_MAX          4095
+#define SENSOR_HAL_RING_LEN         8       // Valores decimados que guarda cada canal continuo
+
+typedef enum {
+    SENSOR_HAL_MODE_ONESHOT,        // La HAL crea la unidad y lee bajo demanda
+    SENSOR_HAL_MODE_CONTINUOUS,     // El dueño del canal usa el driver continuo (DMA)
+} sensor_hal_mode_t;
+
+// Se invoca desde la tarea de adquisición con el promedio de cada trama
+typedef void (*sensor_hal_sample_cb_t)(uint32_t raw, void *arg);
+
+typedef struct {
+    const char *name;
+    adc_unit_t unit;
+    adc_channel_t channel;
+    adc_atten_t atten;
+    sensor_hal_mode_t mode;
+    sensor_hal_sample_cb_t on_sample;   // Opcional, sólo en modo continuo
+    void *on_sample_arg;
+} sensor_hal_channel_config_t;
+
+// Secuencia DMA que recorre todos los canales continuos registrados
+typedef struct {
+    uint32_t sample_freq_hz;        // Conversiones por segundo entre todos los canales
+    uint32_t frame_bytes;
+    uint32_t ring_frames;           // Tramas que el driver puede acumular
+    uint32_t task_stack;
+    UBaseType_t task_priority;
+    BaseType_t task_core;
+} sensor_hal_scan_config_t;
+
+typedef int sensor_hal_channel_t;
+
+// Registra un canal; configura la unidad oneshot y la calibración si aún no existen
+esp_err_t sensor_hal_channel_register(const sensor_hal_channel_config_t *config, sensor_hal_channel_t *out_channel);
+
+// Lectura raw de un canal oneshot
+esp_err_t sensor_hal_read_raw(sensor_hal_channel_t channel, int *out_raw);
+
+// Conversión raw -> mV con la calibración del canal (lineal si no hay calibración)
+esp_err_t sensor_hal_raw_to_mv(sensor_hal_channel_t channel, int raw, int *out_mv);
+
+// Rellena una tabla raw -> mV de 'entries' posiciones (normalmente SENSOR_HAL_RAW_MAX + 1)
+esp_err_t sensor_hal_build_mv_lut(sensor_hal_channel_t channel, uint16_t *lut, size_t entries);
+
+// Arranca la adquisición continua: un patrón DMA, una interrupción y una tarea
+// que demultiplexa cada trama al anillo de su canal. Registrar antes los canales.
+esp_err_t sensor_hal_scan_start(const sensor_hal_scan_config_t *config, TaskHandle_t *out_task);
+
+// Copia los 'max' valores decimados más recientes del canal (el más nuevo primero)
+size_t sensor_hal_scan_read(sensor_hal_channel_t channel, uint16_t *out, size_t max);
+
+// Indica si el canal dispone de calibración real
+bool sensor_hal_is_calibrated(sensor_hal_channel_t channel);
+
+#endif // SENSOR_HAL_H
@@ -0,0 +1,405 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "sensor_hal.h"
+#include <stdlib.h>
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "esp_adc/adc_cali_scheme.h"
+#include "esp_adc/adc_continuous.h"
+
+static const char *TAG = "SENSOR_HAL";
+
+#define SENSOR_HAL_FALLBACK_MV      3300    // Fondo de escala sin calibración (12 dB)
+#define SENSOR_HAL_MAX_CALI         (SOC_ADC_PERIPH_NUM * 4)
+
+typedef struct {
+    adc_unit_t unit;
+    adc_atten_t atten;
+    adc_cali_handle_t handle;       // NULL si el esquema no está soportado
+} sensor_hal_cali_t;
+
+typedef struct {
+    sensor_hal_channel_config_t config;
+    sensor_hal_cali_t *cali;
+    uint16_t ring[SENSOR_HAL_RING_LEN];     // Anillo de valores decimados (modo continuo)
+    uint32_t ring_written;                  // Total de valores escritos en el anillo
+} sensor_hal_entry_t;
+
+// ===== VARIABLES GLOBALES =====
+static adc_oneshot_unit_handle_t oneshot_units[SOC_ADC_PERIPH_NUM];
+static sensor_hal_cali_t cali_table[SENSOR_HAL_MAX_CALI];
+static int cali_count = 0;
+static sensor_hal_entry_t channels[SENSOR_HAL_MAX_CHANNELS];
+static int channel_count = 0;
+
+static adc_continuous_handle_t scan_handle = NULL;
+static TaskHandle_t scan_task_handle = NULL;
+static uint32_t scan_frame_bytes = 0;
+static int8_t scan_slot[SOC_ADC_MAX_CHANNEL_NUM];  // Canal del ADC -> entrada del registro
+static portMUX_TYPE ring_lock = portMUX_INITIALIZER_UNLOCKED;
+static volatile uint32_t scan_frames = 0;
+
+// ===== CALIBRACIÓN (UNA VEZ POR UNIDAD Y ATENUACIÓN) =====
+static adc_cali_handle_t sensor_hal_cali_probe(adc_unit_t unit, adc_atten_t atten)
+{
+    adc_cali_handle_t handle = NULL;
+    esp_err_t ret = ESP_ERR_NOT_SUPPORTED;
+
+#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
+    if (handle == NULL) {
+        adc_cali_curve_fitting_config_t cali_config = {
+            .unit_id = unit,
+            .atten = atten,
+            .bitwidth = ADC_BITWIDTH_DEFAULT,
+        };
+        ret = adc_cali_create_scheme_curve_fitting(&cali_config, &handle);
+        if (ret == ESP_OK) {
+            ESP_LOGI(TAG, "ADC%d atten %d: calibración por curve fitting", unit + 1, atten);
+        }
+    }
+#endif
+
+#if ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
+    if (handle == NULL) {
+        adc_cali_line_fitting_config_t cali_config = {
+            .unit_id = unit,
+            .atten = atten,
+            .bitwidth = ADC_BITWIDTH_DEFAULT,
+        };
+        ret = adc_cali_create_scheme_line_fitting(&cali_config, &handle);
+        if (ret == ESP_OK) {
+            ESP_LOGI(TAG, "ADC%d atten %d: calibración por line fitting", unit + 1, atten);
+        }
+    }
+#endif
+
+    if (handle == NULL) {
+        if (ret == ESP_ERR_NOT_SUPPORTED) {
+            ESP_LOGW(TAG, "ADC%d atten %d: calibración no soportada, usando valores sin calibrar", unit + 1, atten);
+        } else {
+            ESP_LOGE(TAG, "ADC%d atten %d: fallo en la calibración (%s)", unit + 1, atten, esp_err_to_name(ret));
+        }
+    }
+    return handle;
+}
+
+static sensor_hal_cali_t *sensor_hal_cali_get(adc_unit_t unit, adc_atten_t atten)
+{
+    for (int i = 0; i < cali_count; i++) {
+        if (cali_table[i].unit == unit && cali_table[i].atten == atten) {
+            return &cali_table[i];
+        }
+    }
+    if (cali_count >= SENSOR_HAL_MAX_CALI) {
+        return NULL;
+    }
+
+    sensor_hal_cali_t *cali = &cali_table[cali_count++];
+    cali->unit = unit;
+    cali->atten = atten;
+    cali->handle = sensor_hal_cali_probe(unit, atten);
+    return cali;
+}
+
+// ===== REGISTRO DE CANALES =====
+esp_err_t sensor_hal_channel_register(const sensor_hal_channel_config_t *config, sensor_hal_channel_t *out_channel)
+{
+    if (config == NULL || out_channel == NULL || config->unit >= SOC_ADC_PERIPH_NUM) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (config->mode == SENSOR_HAL_MODE_CONTINUOUS && scan_handle != NULL) {
+        return ESP_ERR_INVALID_STATE;       // El patrón DMA ya está fijado
+    }
+    if (channel_count >= SENSOR_HAL_MAX_CHANNELS) {
+        ESP_LOGE(TAG, "Registro lleno, no se puede añadir '%s'", config->name);
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (config->mode == SENSOR_HAL_MODE_ONESHOT) {
+        if (oneshot_units[config->unit] == NULL) {
+            adc_oneshot_unit_init_cfg_t unit_config = {
+                .unit_id = config->unit,
+            };
+            esp_err_t ret = adc_oneshot_new_unit(&unit_config, &oneshot_units[config->unit]);
+            if (ret != ESP_OK) {
+                return ret;
+            }
+        }
+
+        adc_oneshot_chan_cfg_t chan_config = {
+            .bitwidth = ADC_BITWIDTH_DEFAULT,
+            .atten = config->atten,
+        };
+        esp_err_t ret = adc_oneshot_config_channel(oneshot_units[config->unit], config->channel, &chan_config);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    sensor_hal_cali_t *cali = sensor_hal_cali_get(config->unit, config->atten);
+    if (cali == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+
+    channels[channel_count] = (sensor_hal_entry_t) {
+        .config = *config,
+        .cali = cali,
+    };
+    *out_channel = channel_count++;
+
+    ESP_LOGI(TAG, "Canal '%s' registrado: ADC%d_CH%d", config->name, config->unit + 1, config->channel);
+    return ESP_OK;
+}
+
+// ===== LECTURA Y CONVERSIÓN =====
+esp_err_t sensor_hal_read_raw(sensor_hal_channel_t channel, int *out_raw)
+{
+    if (channel < 0 || channel >= channel_count || out_raw == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const sensor_hal_channel_config_t *config = &channels[channel].config;
+    if (config->mode != SENSOR_HAL_MODE_ONESHOT) {
+        return ESP_ERR_INVALID_STATE;
+    }
+    return adc_oneshot_read(oneshot_units[config->unit], config->channel, out_raw);
+}
+
+esp_err_t sensor_hal_raw_to_mv(sensor_hal_channel_t channel, int raw, int *out_mv)
+{
+    if (channel < 0 || channel >= channel_count || out_mv == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    adc_cali_handle_t handle = channels[channel].cali->handle;
+    if (handle != NULL) {
+        return adc_cali_raw_to_voltage(handle, raw, out_mv);
+    }
+    *out_mv = (raw * SENSOR_HAL_FALLBACK_MV) / SENSOR_HAL_RAW_MAX;
+    return ESP_OK;
+}
+
+esp_err_t sensor_hal_build_mv_lut(sensor_hal_channel_t channel, uint16_t *lut, size_t entries)
+{
+    if (lut == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (size_t raw = 0; raw < entries; raw++) {
+        int mv = 0;
+        esp_err_t ret = sensor_hal_raw_to_mv(channel, (int)raw, &mv);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        lut[raw] = (uint16_t)mv;
+    }
+    return ESP_OK;
+}
+
+bool sensor_hal_is_calibrated(sensor_hal_channel_t channel)
+{
+    if (channel < 0 || channel >= channel_count) {
+        return false;
+    }
+    return channels[channel].cali->handle != NULL;
+}
+
+// ===== ADQUISICIÓN CONTINUA MULTICANAL (DMA) =====
+static bool IRAM_ATTR sensor_hal_conv_done_cb(adc_continuous_handle_t handle,
+                                              const adc_continuous_evt_data_t *edata, void *user_data)
+{
+    BaseType_t must_yield = pdFALSE;
+    vTaskNotifyGiveFromISR(scan_task_handle, &must_yield);
+    return (must_yield == pdTRUE);
+}
+
+static void sensor_hal_ring_push(sensor_hal_entry_t *entry, uint16_t raw)
+{
+    taskENTER_CRITICAL(&ring_lock);
+    entry->ring[entry->ring_written % SENSOR_HAL_RING_LEN] = raw;
+    entry->ring_written++;
+    taskEXIT_CRITICAL(&ring_lock);
+}
+
+// Promedia cada canal de la trama y lo entrega a su anillo
+static void sensor_hal_demux_frame(const uint8_t *frame, uint32_t length)
+{
+    uint32_t sum[SENSOR_HAL_MAX_CHANNELS] = {0};
+    uint32_t count[SENSOR_HAL_MAX_CHANNELS] = {0};
+
+    for (uint32_t i = 0; i < length; i += SOC_ADC_DIGI_RESULT_BYTES) {
+        const adc_digi_output_data_t *p = (const adc_digi_output_data_t *)&frame[i];
+        if (p->type1.channel >= SOC_ADC_MAX_CHANNEL_NUM) {
+            continue;
+        }
+        int slot = scan_slot[p->type1.channel];
+        if (slot < 0) {
+            continue;
+        }
+        sum[slot] += p->type1.data;
+        count[slot]++;
+    }
+
+    for (int slot = 0; slot < channel_count; slot++) {
+        if (count[slot] == 0) {
+            continue;
+        }
+        sensor_hal_entry_t *entry = &channels[slot];
+        uint32_t raw = sum[slot] / count[slot];
+        sensor_hal_ring_push(entry, (uint16_t)raw);
+        if (entry->config.on_sample != NULL) {
+            entry->config.on_sample(raw, entry->config.on_sample_arg);
+        }
+    }
+}
+
+static void sensor_hal_scan_task(void *arg)
+{
+    uint8_t *frame = (uint8_t *)arg;
+    uint32_t length = 0;
+
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        // Vaciar todas las tramas pendientes del anillo del driver sin bloquear
+        while (adc_continuous_read(scan_handle, frame, scan_frame_bytes, &length, 0) == ESP_OK) {
+            sensor_hal_demux_frame(frame, length);
+            scan_frames++;
+        }
+    }
+}
+
+// Deshace un arranque fallido para que sensor_hal_scan_start pueda volver a intentarse
+static void sensor_hal_scan_abort(uint8_t *frame)
+{
+    if (scan_task_handle != NULL) {
+        vTaskDelete(scan_task_handle);
+        scan_task_handle = NULL;
+    }
+    adc_continuous_deinit(scan_handle);
+    scan_handle = NULL;
+    free(frame);
+}
+
+esp_err_t sensor_hal_scan_start(const sensor_hal_scan_config_t *config, TaskHandle_t *out_task)
+{
+    adc_digi_pattern_config_t pattern[SENSOR_HAL_MAX_CHANNELS];
+    uint32_t pattern_num = 0;
+    adc_unit_t unit = ADC_UNIT_1;
+
+    if (config == NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (scan_handle != NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    for (int i = 0; i < SOC_ADC_MAX_CHANNEL_NUM; i++) {
+        scan_slot[i] = -1;
+    }
+    for (int slot = 0; slot < channel_count; slot++) {
+        const sensor_hal_channel_config_t *ch = &channels[slot].config;
+        if (ch->mode != SENSOR_HAL_MODE_CONTINUOUS) {
+            continue;
+        }
+        // Un único patrón DMA: todos los canales deben pertenecer a la misma unidad
+        if (pattern_num > 0 && ch->unit != unit) {
+            ESP_LOGE(TAG, "El canal '%s' no está en ADC%d", ch->name, unit + 1);
+            return ESP_ERR_NOT_SUPPORTED;
+        }
+        unit = ch->unit;
+        pattern[pattern_num++] = (adc_digi_pattern_config_t) {
+            .atten = ch->atten,
+            .channel = ch->channel & 0x7,
+            .unit = ch->unit,
+            .bit_width = SOC_ADC_DIGI_MAX_BITWIDTH,
+        };
+        scan_slot[ch->channel] = (int8_t)slot;
+    }
+    if (pattern_num == 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    uint8_t *frame = malloc(config->frame_bytes);
+    if (frame == NULL) {
+        return ESP_ERR_NO_MEM;
+    }
+    scan_frame_bytes = config->frame_bytes;
+
+    adc_continuous_handle_cfg_t handle_config = {
+        .max_store_buf_size = config->frame_bytes * config->ring_frames,
+        .conv_frame_size = config->frame_bytes,
+    };
+    esp_err_t ret = adc_continuous_new_handle(&handle_config, &scan_handle);
+    if (ret != ESP_OK) {
+        free(frame);
+        scan_handle = NULL;
+        return ret;
+    }
+
+    adc_continuous_config_t dig_config = {
+        .pattern_num = pattern_num,
+        .adc_pattern = pattern,
+        .sample_freq_hz = config->sample_freq_hz,
+        .conv_mode = (unit == ADC_UNIT_1) ? ADC_CONV_SINGLE_UNIT_1 : ADC_CONV_SINGLE_UNIT_2,
+        .format = ADC_DIGI_OUTPUT_FORMAT_TYPE1,
+    };
+    ret = adc_continuous_config(scan_handle, &dig_config);
+    if (ret != ESP_OK) {
+        sensor_hal_scan_abort(frame);
+        return ret;
+    }
+
+    // El callback no se dispara hasta adc_continuous_start, así que puede registrarse antes de crear la tarea
+    adc_continuous_evt_cbs_t cbs = {
+        .on_conv_done = sensor_hal_conv_done_cb,
+    };
+    ret = adc_continuous_register_event_callbacks(scan_handle, &cbs, NULL);
+    if (ret != ESP_OK) {
+        sensor_hal_scan_abort(frame);
+        return ret;
+    }
+
+    if (xTaskCreatePinnedToCore(sensor_hal_scan_task, "adc_scan_task", config->task_stack, frame,
+                                config->task_priority, &scan_task_handle, config->task_core) != pdPASS) {
+        ESP_LOGE(TAG, "Error creando la tarea de adquisición del ADC");
+        scan_task_handle = NULL;
+        sensor_hal_scan_abort(frame);
+        return ESP_ERR_NO_MEM;
+    }
+
+    ret = adc_continuous_start(scan_handle);
+    if (ret != ESP_OK) {
+        sensor_hal_scan_abort(frame);
+        return ret;
+    }
+
+    // Esperar la primera trama para que las lecturas iniciales sean válidas
+    for (int i = 0; i < 10 && scan_frames == 0; i++) {
+        vTaskDelay(pdMS_TO_TICKS(10));
+    }
+
+    ESP_LOGI(TAG, "Escaneo ADC%d: %lu canales, %lu Hz, %lu conversiones/trama",
+             unit + 1, (unsigned long)pattern_num, (unsigned long)config->sample_freq_hz,
+             (unsigned long)(config->frame_bytes / SOC_ADC_DIGI_RESULT_BYTES));
+
+    if (out_task != NULL) {
+        *out_task = scan_task_handle;
+    }
+    return ESP_OK;
+}
+
+size_t sensor_hal_scan_read(sensor_hal_channel_t channel, uint16_t *out, size_t max)
+{
+    if (channel < 0 || channel >= channel_count || out == NULL) {
+        return 0;
+    }
+    sensor_hal_entry_t *entry = &channels[channel];
+    size_t n = 0;
+
+    taskENTER_CRITICAL(&ring_lock);
+    uint32_t written = entry->ring_written;
+    while (n < max && n < SENSOR_HAL_RING_LEN && n < written) {
+        out[n] = entry->ring[(written - 1 - n) % SENSOR_HAL_RING_LEN];
+        n++;
+    }
+    taskEXIT_CRITICAL(&ring_lock);
+
+    return n;
+}
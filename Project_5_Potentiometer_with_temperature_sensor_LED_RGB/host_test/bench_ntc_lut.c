@@ -0,0 +1,75 @@
+// ===== BENCHMARK DE LA TABLA DE CONVERSIÓN DE LA NTC =====
+// Construye la tabla de 129 nodos de duty_map.c y la compara con la ecuación
+// Beta que sustituye: error máximo en TEMP_MIN..TEMP_MAX y ns por conversión
+// en todo el rango del ADC. Falla si el error supera NTC_LUT_MAX_ERR_C.
+// Los ns dependen del host, no del ESP32: sólo la proporción es orientativa.
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "duty_map.h"
+#include "ntc_sensor.h"
+
+#define NTC_LUT_MAX_ERR_C   0.01    // Un cuarto de LSB del LED rojo (40 °C / 1023 ≈ 0.04 °C por LSB)
+#define BENCH_ROUNDS        2000
+
+static double now_s(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(void)
+{
+    volatile float sink_f = 0;
+    volatile q16_t sink_q = 0;
+    double max_err = 0;
+    int max_err_raw = 0;
+    double start, beta_s, lut_s;
+    double conversions = (double)(ADC_RAW_MAX - 1) * BENCH_ROUNDS;
+
+    ntc_lut_build();
+
+    // Error sólo donde se usa la lectura: fuera de TEMP_MIN..TEMP_MAX el duty satura
+    for (int raw = 1; raw < ADC_RAW_MAX; raw++) {
+        double ref = ntc_beta_temperature(raw);
+        if (ref < TEMP_MIN || ref > TEMP_MAX) {
+            continue;
+        }
+        double err = fabs(ref - (double)ntc_lut_lookup_q16(raw) / Q16_ONE);
+        if (err > max_err) {
+            max_err = err;
+            max_err_raw = raw;
+        }
+    }
+
+    start = now_s();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int raw = 1; raw < ADC_RAW_MAX; raw++) {
+            sink_f = ntc_beta_temperature(raw);
+        }
+    }
+    beta_s = now_s() - start;
+
+    start = now_s();
+    for (int round = 0; round < BENCH_ROUNDS; round++) {
+        for (int raw = 1; raw < ADC_RAW_MAX; raw++) {
+            sink_q = ntc_lut_lookup_q16(raw);
+        }
+    }
+    lut_s = now_s() - start;
+    (void)sink_f;
+    (void)sink_q;
+
+    printf("Tabla de %d nodos: error máximo %.4f °C en raw=%d (rango %.0f..%.0f °C)\n",
+           NTC_LUT_SIZE, max_err, max_err_raw, TEMP_MIN, TEMP_MAX);
+    printf("Beta %.1f ns/conversión, tabla %.1f ns/conversión (x%.1f)\n",
+           beta_s * 1e9 / conversions, lut_s * 1e9 / conversions, beta_s / lut_s);
+
+    if (max_err > NTC_LUT_MAX_ERR_C) {
+        printf("FALLO: el error supera %.2f °C\n", NTC_LUT_MAX_ERR_C);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
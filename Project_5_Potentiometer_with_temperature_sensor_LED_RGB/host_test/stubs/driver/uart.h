@@ -0,0 +1,16 @@
+#ifndef HOST_STUB_UART_H
+#define HOST_STUB_UART_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "esp_err.h"
+
+typedef int uart_port_t;
+
+// Las pruebas que escriben en la UART aportan su propia implementación
+bool uart_is_driver_installed(uart_port_t uart_num);
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              void *uart_queue, int intr_alloc_flags);
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size);
+
+#endif // HOST_STUB_UART_H
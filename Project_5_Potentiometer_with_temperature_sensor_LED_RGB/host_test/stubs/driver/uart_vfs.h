@@ -0,0 +1,6 @@
+#ifndef HOST_STUB_UART_VFS_H
+#define HOST_STUB_UART_VFS_H
+
+void uart_vfs_dev_use_driver(int uart_num);
+
+#endif // HOST_STUB_UART_VFS_H
@@ -0,0 +1,12 @@
+#ifndef HOST_STUB_ESP_LOG_H
+#define HOST_STUB_ESP_LOG_H
+
+#include <stdio.h>
+#include "esp_err.h"
+
+// Los logs van a stderr para no mezclarse con lo que la prueba escribe en stdout
+#define ESP_LOGE(tag, fmt, ...)     fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...)     fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...)     fprintf(stderr, "I %s: " fmt "\n", tag, ##__VA_ARGS__)
+
+#endif // HOST_STUB_ESP_LOG_H
@@ -0,0 +1,26 @@
+#ifndef HOST_STUB_FREERTOS_H
+#define HOST_STUB_FREERTOS_H
+
+#include <stdint.h>
+#include <pthread.h>
+
+// Sustituto mínimo para compilar en el host: la sección crítica pasa a ser un mutex de pthreads
+typedef struct {
+    pthread_mutex_t mutex;
+} portMUX_TYPE;
+
+#define portMUX_INITIALIZE(mux)     pthread_mutex_init(&(mux)->mutex, NULL)
+#define taskENTER_CRITICAL(mux)     pthread_mutex_lock(&(mux)->mutex)
+#define taskEXIT_CRITICAL(mux)      pthread_mutex_unlock(&(mux)->mutex)
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE                     0
+#define pdTRUE                      1
+#define pdPASS                      pdTRUE
+#define portMAX_DELAY               ((TickType_t)0xffffffffUL)
+#define tskNO_AFFINITY              0x7FFFFFFF
+
+#endif // HOST_STUB_FREERTOS_H
@@ -0,0 +1,19 @@
+#ifndef HOST_STUB_RINGBUF_H
+#define HOST_STUB_RINGBUF_H
+
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+
+typedef void *RingbufHandle_t;
+
+typedef enum {
+    RINGBUF_TYPE_NOSPLIT = 0,
+} RingbufferType_t;
+
+// Las pruebas que usan el anillo aportan su propia implementación
+RingbufHandle_t xRingbufferCreate(size_t size, RingbufferType_t type);
+BaseType_t xRingbufferSend(RingbufHandle_t ring, const void *item, size_t size, TickType_t ticks);
+void *xRingbufferReceive(RingbufHandle_t ring, size_t *size, TickType_t ticks);
+void vRingbufferReturnItem(RingbufHandle_t ring, void *item);
+
+#endif // HOST_STUB_RINGBUF_H
@@ -0,0 +1,13 @@
+#ifndef HOST_STUB_TASK_H
+#define HOST_STUB_TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+typedef void *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+// Las pruebas que crean tareas aportan su propia implementación
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stack_depth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core);
+
+#endif // HOST_STUB_TASK_H
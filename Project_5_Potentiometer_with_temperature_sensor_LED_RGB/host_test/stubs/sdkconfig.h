@@ -0,0 +1,7 @@
+#ifndef HOST_STUB_SDKCONFIG_H
+#define HOST_STUB_SDKCONFIG_H
+
+// Sólo las opciones que leen los módulos compilados en el host
+#define CONFIG_ESP_CONSOLE_UART_NUM     0
+
+#endif // HOST_STUB_SDKCONFIG_H
@@ -0,0 +1,240 @@
+// ===== PRUEBAS DE RESPUESTA DE LOS FILTROS ADC =====
+// Respuesta al escalón y al impulso de cada filtro de components/adc_filter, y
+// de la cadena completa del potenciómetro (mediana 3 -> IIR >> 2 -> banda
+// muerta de 8), que debe llegar a 0 y a fondo de escala.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include "adc_filter.h"
+
+#define RAW_MAX         4095
+
+// Parámetros de la cadena de potentiometer.c
+#define POT_MEDIAN_WINDOW       3
+#define POT_IIR_SHIFT           2
+#define POT_DEADBAND_RAW        8
+
+static int failures = 0;
+
+#define CHECK(cond, ...) do {                                   \
+        if (!(cond)) {                                          \
+            printf("FALLO %s:%d: ", __func__, __LINE__);        \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+            failures++;                                         \
+        }                                                       \
+    } while (0)
+
+// ===== MEDIA MÓVIL =====
+static void test_ma_step(void)
+{
+    adc_filter_ma_t f;
+    adc_filter_ma_init(&f, 4);
+    for (int i = 0; i < 8; i++) {
+        CHECK(adc_filter_ma_update(&f, 0) == 0, "reposo distinto de 0");
+    }
+    // La salida sube en rampa durante una ventana y se queda en el valor final
+    const uint32_t expected[] = {250, 500, 750, 1000, 1000, 1000};
+    for (int i = 0; i < 6; i++) {
+        uint32_t y = adc_filter_ma_update(&f, 1000);
+        CHECK(y == expected[i], "muestra %d: %lu, se esperaba %lu", i, (unsigned long)y, (unsigned long)expected[i]);
+    }
+}
+
+static void test_ma_impulse(void)
+{
+    adc_filter_ma_t f;
+    adc_filter_ma_init(&f, 4);
+    for (int i = 0; i < 4; i++) {
+        adc_filter_ma_update(&f, 0);
+    }
+    // Un impulso aparece atenuado 1/ventana durante exactamente una ventana
+    const uint32_t expected[] = {250, 250, 250, 250, 0, 0};
+    for (int i = 0; i < 6; i++) {
+        uint32_t y = adc_filter_ma_update(&f, i == 0 ? 1000 : 0);
+        CHECK(y == expected[i], "muestra %d: %lu, se esperaba %lu", i, (unsigned long)y, (unsigned long)expected[i]);
+    }
+}
+
+// ===== IIR DE UN POLO =====
+static void test_iir_step(void)
+{
+    adc_filter_iir_t f;
+    adc_filter_iir_init(&f, 2);
+    CHECK(adc_filter_iir_update(&f, 0) == 0, "la primera muestra debe inicializar el estado");
+
+    // y[n] = 4000 * (1 - (3/4)^n): sin sobreoscilación, monótona y sin error final
+    double ideal = 0.0;
+    uint32_t previous = 0;
+    for (int n = 1; n <= 60; n++) {
+        uint32_t y = adc_filter_iir_update(&f, 4000);
+        ideal += (4000.0 - ideal) / 4.0;
+        CHECK(abs((int)y - (int)(ideal + 0.5)) <= 1, "muestra %d: %lu, ideal %.1f", n, (unsigned long)y, ideal);
+        CHECK(y >= previous && y <= 4000, "muestra %d: %lu no es monótona o sobreoscila", n, (unsigned long)y);
+        previous = y;
+    }
+    CHECK(previous == 4000, "valor final %lu, se esperaba 4000", (unsigned long)previous);
+}
+
+static void test_iir_impulse(void)
+{
+    adc_filter_iir_t f;
+    adc_filter_iir_init(&f, 2);
+    adc_filter_iir_update(&f, 0);
+
+    // El impulso entra con ganancia 1/4 y decae un factor 3/4 por muestra hasta 0
+    uint32_t y = adc_filter_iir_update(&f, 4000);
+    CHECK(y == 1000, "pico %lu, se esperaba 1000", (unsigned long)y);
+    double ideal = 1000.0;
+    for (int n = 1; n <= 60; n++) {
+        y = adc_filter_iir_update(&f, 0);
+        ideal *= 0.75;
+        CHECK(abs((int)y - (int)(ideal + 0.5)) <= 1, "muestra %d: %lu, ideal %.1f", n, (unsigned long)y, ideal);
+    }
+    CHECK(y == 0, "no vuelve a 0: %lu", (unsigned long)y);
+}
+
+// ===== MEDIANA =====
+static void test_median_impulse(void)
+{
+    adc_filter_median_t f;
+    adc_filter_median_init(&f, 3);
+    for (int i = 0; i < 3; i++) {
+        adc_filter_median_update(&f, 2000);
+    }
+    // Un pico aislado se descarta por completo
+    for (int i = 0; i < 5; i++) {
+        uint32_t y = adc_filter_median_update(&f, i == 0 ? RAW_MAX : 2000);
+        CHECK(y == 2000, "muestra %d: %lu, el pico no se descartó", i, (unsigned long)y);
+    }
+
+    // Con ventana 5 se descartan picos de hasta 2 muestras
+    adc_filter_median_init(&f, 5);
+    for (int i = 0; i < 5; i++) {
+        adc_filter_median_update(&f, 2000);
+    }
+    for (int i = 0; i < 7; i++) {
+        uint32_t y = adc_filter_median_update(&f, i < 2 ? 0 : 2000);
+        CHECK(y == 2000, "muestra %d: %lu, el pico doble no se descartó", i, (unsigned long)y);
+    }
+}
+
+static void test_median_step(void)
+{
+    adc_filter_median_t f;
+    adc_filter_median_init(&f, 3);
+    for (int i = 0; i < 3; i++) {
+        adc_filter_median_update(&f, 1000);
+    }
+    // Un escalón pasa íntegro con (ventana - 1) / 2 muestras de retardo
+    const uint32_t expected[] = {1000, 3000, 3000, 3000};
+    for (int i = 0; i < 4; i++) {
+        uint32_t y = adc_filter_median_update(&f, 3000);
+        CHECK(y == expected[i], "muestra %d: %lu, se esperaba %lu", i, (unsigned long)y, (unsigned long)expected[i]);
+    }
+}
+
+// ===== BANDA MUERTA =====
+static void test_deadband_step(void)
+{
+    adc_filter_deadband_t f;
+    adc_filter_deadband_init(&f, 8, RAW_MAX);
+    CHECK(adc_filter_deadband_update(&f, 2000) == 2000, "la primera muestra debe pasar");
+
+    // Variaciones de hasta la banda se ignoran; un escalón mayor se sigue de inmediato
+    const uint32_t input[] = {2008, 1992, 2005, 2009, 2001, 1500};
+    const uint32_t expected[] = {2000, 2000, 2000, 2009, 2009, 1500};
+    for (int i = 0; i < 6; i++) {
+        uint32_t y = adc_filter_deadband_update(&f, input[i]);
+        CHECK(y == expected[i], "muestra %d: %lu, se esperaba %lu", i, (unsigned long)y, (unsigned long)expected[i]);
+    }
+}
+
+static void test_deadband_rails(void)
+{
+    adc_filter_deadband_t f;
+    adc_filter_deadband_init(&f, 8, RAW_MAX);
+
+    // Los extremos se alcanzan aunque estén a menos de la banda de la salida
+    adc_filter_deadband_update(&f, RAW_MAX - 5);
+    CHECK(adc_filter_deadband_update(&f, RAW_MAX) == RAW_MAX, "no alcanza el fondo de escala");
+    adc_filter_deadband_update(&f, 5);
+    CHECK(adc_filter_deadband_update(&f, 0) == 0, "no alcanza el 0");
+}
+
+// ===== CADENA DEL POTENCIÓMETRO =====
+typedef struct {
+    adc_filter_median_t median;
+    adc_filter_iir_t iir;
+    adc_filter_deadband_t deadband;
+} pot_chain_t;
+
+static void pot_chain_init(pot_chain_t *chain)
+{
+    adc_filter_median_init(&chain->median, POT_MEDIAN_WINDOW);
+    adc_filter_iir_init(&chain->iir, POT_IIR_SHIFT);
+    adc_filter_deadband_init(&chain->deadband, POT_DEADBAND_RAW, RAW_MAX);
+}
+
+static uint32_t pot_chain_update(pot_chain_t *chain, uint32_t raw)
+{
+    raw = adc_filter_median_update(&chain->median, raw);
+    raw = adc_filter_iir_update(&chain->iir, raw);
+    return adc_filter_deadband_update(&chain->deadband, raw);
+}
+
+static void test_pot_chain_reaches_rails(void)
+{
+    pot_chain_t chain;
+    uint32_t y = 0;
+
+    // Escalones desde el centro hasta cada extremo
+    pot_chain_init(&chain);
+    for (int i = 0; i < 10; i++) {
+        pot_chain_update(&chain, 2048);
+    }
+    for (int i = 0; i < 100; i++) {
+        y = pot_chain_update(&chain, RAW_MAX);
+    }
+    CHECK(y == RAW_MAX, "escalón a fondo de escala se queda en %lu", (unsigned long)y);
+    for (int i = 0; i < 100; i++) {
+        y = pot_chain_update(&chain, 0);
+    }
+    CHECK(y == 0, "escalón a 0 se queda en %lu", (unsigned long)y);
+
+    // Rampa lenta (girar el potenciómetro despacio) hasta cada extremo
+    for (uint32_t raw = 0; raw <= RAW_MAX; raw += 3) {
+        pot_chain_update(&chain, raw);
+    }
+    for (int i = 0; i < 100; i++) {
+        y = pot_chain_update(&chain, RAW_MAX);
+    }
+    CHECK(y == RAW_MAX, "rampa a fondo de escala se queda en %lu", (unsigned long)y);
+    for (int raw = RAW_MAX; raw >= 0; raw -= 3) {
+        pot_chain_update(&chain, (uint32_t)raw);
+    }
+    for (int i = 0; i < 100; i++) {
+        y = pot_chain_update(&chain, 0);
+    }
+    CHECK(y == 0, "rampa a 0 se queda en %lu", (unsigned long)y);
+}
+
+int main(void)
+{
+    test_ma_step();
+    test_ma_impulse();
+    test_iir_step();
+    test_iir_impulse();
+    test_median_impulse();
+    test_median_step();
+    test_deadband_step();
+    test_deadband_rails();
+    test_pot_chain_reaches_rails();
+
+    if (failures != 0) {
+        printf("%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,107 @@
+// ===== PRUEBA DEL MAPEO A DUTY EN PUNTO FIJO =====
+// Compara el camino Q16.16 de duty_map.c con el camino original (float para
+// la NTC, división entera para el LED verde) en todo el rango de entrada y
+// falla si la diferencia de duty supera 1 LSB.
+#include <stdio.h>
+#include <stdlib.h>
+#include "duty_map.h"
+#include "ntc_sensor.h"
+
+#define MAX_DIFF_LSB    1
+#define SWEEP_MARGIN_C  5       // Se recorre también fuera de TEMP_MIN..TEMP_MAX para cubrir la saturación
+
+static int failures = 0;
+
+static void report(const char *name, int max_diff, const char *where)
+{
+    printf("%s: diferencia máxima de duty %d LSB (%s)\n", name, max_diff, where);
+    if (max_diff > MAX_DIFF_LSB) {
+        printf("FALLO: %s supera %d LSB\n", name, MAX_DIFF_LSB);
+        failures++;
+    }
+}
+
+// Todos los códigos del ADC, tal y como llegan a ntc_read_temperature
+static void test_ntc_adc_sweep(void)
+{
+    int max_diff = 0;
+    int max_diff_raw = 0;
+    char where[64];
+
+    for (int raw = 0; raw <= ADC_RAW_MAX; raw++) {
+        q16_t temperature_q16 = ntc_lut_lookup_q16(raw);
+        int duty_fixed = ntc_map_duty_q16(temperature_q16, NULL);
+        int duty_float = ntc_map_duty_float((float)temperature_q16 / Q16_ONE, NULL);
+        int diff = abs(duty_fixed - duty_float);
+        if (diff > max_diff) {
+            max_diff = diff;
+            max_diff_raw = raw;
+        }
+    }
+    snprintf(where, sizeof(where), "peor caso en raw=%d", max_diff_raw);
+    report("NTC, códigos del ADC", max_diff, where);
+}
+
+// Cada valor Q16.16 entre TEMP_MIN y TEMP_MAX (y un margen a cada lado)
+static void test_ntc_temperature_sweep(void)
+{
+    const q16_t first = Q16_CONST(TEMP_MIN - SWEEP_MARGIN_C);
+    const q16_t last = Q16_CONST(TEMP_MAX + SWEEP_MARGIN_C);
+    int max_diff = 0;
+    q16_t max_diff_t = first;
+    char where[64];
+
+    for (q16_t t = first; t <= last; t++) {
+        int diff = abs(ntc_map_duty_q16(t, NULL) - ntc_map_duty_float((float)t / Q16_ONE, NULL));
+        if (diff > max_diff) {
+            max_diff = diff;
+            max_diff_t = t;
+        }
+    }
+    snprintf(where, sizeof(where), "peor caso en %.5f °C", (double)max_diff_t / Q16_ONE);
+    report("NTC, temperaturas Q16.16", max_diff, where);
+
+    if (ntc_map_duty_q16(Q16_CONST(TEMP_MAX), NULL) != NTC_DUTY_MAX || ntc_map_duty_q16(Q16_CONST(TEMP_MIN), NULL) != 0) {
+        printf("FALLO: TEMP_MIN/TEMP_MAX no dan 0/%d\n", NTC_DUTY_MAX);
+        failures++;
+    }
+}
+
+// Todos los porcentajes que admite rgb_set_green_percent
+static void test_green_sweep(void)
+{
+    int max_diff = 0;
+    int max_diff_percent = 0;
+    char where[64];
+
+    for (int percent = 0; percent <= 100; percent++) {
+        int diff = abs((int)green_duty_q16(percent) - (int)green_duty_div(percent));
+        if (diff > max_diff) {
+            max_diff = diff;
+            max_diff_percent = percent;
+        }
+    }
+    snprintf(where, sizeof(where), "peor caso en %d %%", max_diff_percent);
+    report("LED verde, porcentajes", max_diff, where);
+
+    if (green_duty_q16(100) != GREEN_DUTY_MAX || green_duty_q16(0) != 0) {
+        printf("FALLO: 0/100 %% no dan 0/%d\n", GREEN_DUTY_MAX);
+        failures++;
+    }
+}
+
+int main(void)
+{
+    ntc_lut_build();
+
+    test_ntc_adc_sweep();
+    test_ntc_temperature_sweep();
+    test_green_sweep();
+
+    if (failures != 0) {
+        printf("%d comprobaciones fallidas\n", failures);
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
@@ -0,0 +1,161 @@
+// ===== PRUEBA DE ESTRÉS DEL BUZÓN SEQLOCK =====
+// Un hilo escritor publica sin pausa bloques de pares (a, ~a); un hilo lector
+// toma instantáneas a la vez y comprueba que ninguna mezcla dos publicaciones
+// (lectura partida) ni retrocede en el tiempo.
+//
+// Antes se repite lo mismo con un memcpy sin sincronizar como control: si ahí
+// no aparece ninguna lectura partida, la máquina no ha llegado a solapar los
+// hilos y el resultado del buzón no demuestra nada (se avisa, no se falla).
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "mailbox.h"
+
+#define PUBLISH_COUNT   20000
+#define PAIR_COUNT      4096    // Bloque de 32 KB: la copia es larga y la expropiación suele caer dentro
+
+typedef struct {
+    uint32_t a[PAIR_COUNT];
+    uint32_t not_a[PAIR_COUNT];
+} pair_block_t;
+
+typedef struct {
+    void (*publish)(const pair_block_t *block);
+    void (*snapshot)(pair_block_t *block);
+} access_ops_t;
+
+typedef struct {
+    unsigned long snapshots;
+    unsigned long torn;
+    unsigned long backwards;
+    unsigned long changes;      // Instantáneas con un valor distinto del anterior
+} reader_result_t;
+
+static mailbox_t mailbox;
+static pair_block_t mailbox_storage;
+static pair_block_t raw_storage;
+static pair_block_t writer_block;
+static pair_block_t reader_block;
+static atomic_bool writer_done;
+
+// ===== ACCESO CON Y SIN SEQLOCK =====
+static void mailbox_ops_publish(const pair_block_t *block)
+{
+    mailbox_publish(&mailbox, block);
+}
+
+static void mailbox_ops_snapshot(pair_block_t *block)
+{
+    mailbox_snapshot(&mailbox, block);
+}
+
+static void raw_ops_publish(const pair_block_t *block)
+{
+    memcpy(&raw_storage, block, sizeof(raw_storage));
+    atomic_signal_fence(memory_order_seq_cst);  // Sólo impide que el compilador elimine la copia
+}
+
+static void raw_ops_snapshot(pair_block_t *block)
+{
+    atomic_signal_fence(memory_order_seq_cst);
+    memcpy(block, &raw_storage, sizeof(raw_storage));
+}
+
+static const access_ops_t mailbox_ops = { mailbox_ops_publish, mailbox_ops_snapshot };
+static const access_ops_t raw_ops = { raw_ops_publish, raw_ops_snapshot };
+
+// ===== HILOS DE PRUEBA =====
+static void fill_block(pair_block_t *block, uint32_t value)
+{
+    for (int i = 0; i < PAIR_COUNT; i++) {
+        block->a[i] = value;
+        block->not_a[i] = ~value;
+    }
+}
+
+// Devuelve true si todas las parejas pertenecen a la misma publicación
+static bool block_is_consistent(const pair_block_t *block)
+{
+    for (int i = 0; i < PAIR_COUNT; i++) {
+        if (block->a[i] != block->a[0] || block->not_a[i] != (uint32_t)~block->a[0]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void *writer_thread(void *arg)
+{
+    const access_ops_t *ops = arg;
+    for (uint32_t value = 1; value <= PUBLISH_COUNT; value++) {
+        fill_block(&writer_block, value);
+        ops->publish(&writer_block);
+    }
+    atomic_store(&writer_done, true);
+    return NULL;
+}
+
+static reader_result_t run_stress(const access_ops_t *ops)
+{
+    reader_result_t result = {0};
+    uint32_t last = 0;
+    pthread_t writer;
+
+    // El almacenamiento arranca a ceros, que no es un par válido: se publica el valor 0 antes de lanzar el escritor
+    fill_block(&writer_block, 0);
+    ops->publish(&writer_block);
+    atomic_store(&writer_done, false);
+
+    pthread_create(&writer, NULL, writer_thread, (void *)ops);
+    while (!atomic_load(&writer_done)) {
+        ops->snapshot(&reader_block);
+        result.snapshots++;
+        if (!block_is_consistent(&reader_block)) {
+            result.torn++;
+            continue;
+        }
+        if (reader_block.a[0] < last) {
+            result.backwards++;
+        } else if (reader_block.a[0] != last) {
+            result.changes++;
+        }
+        last = reader_block.a[0];
+    }
+    pthread_join(writer, NULL);
+    return result;
+}
+
+static void print_result(const char *name, const reader_result_t *result)
+{
+    printf("%s: %d publicaciones, %lu instantáneas (%lu con valor nuevo), %lu partidas, %lu hacia atrás\n",
+           name, PUBLISH_COUNT, result->snapshots, result->changes, result->torn, result->backwards);
+}
+
+int main(void)
+{
+    mailbox_init(&mailbox, &mailbox_storage, sizeof(mailbox_storage));
+
+    reader_result_t control = run_stress(&raw_ops);
+    print_result("control sin seqlock", &control);
+    if (control.torn == 0) {
+        printf("AVISO: el control no produjo lecturas partidas; los hilos apenas se han solapado\n");
+    }
+
+    reader_result_t result = run_stress(&mailbox_ops);
+    print_result("mailbox", &result);
+
+    mailbox_snapshot(&mailbox, &reader_block);
+    if (result.torn != 0 || result.backwards != 0) {
+        printf("FALLO: el buzón entregó instantáneas incoherentes\n");
+        return 1;
+    }
+    if (!block_is_consistent(&reader_block) || reader_block.a[0] != PUBLISH_COUNT) {
+        printf("FALLO: se perdió la última publicación\n");
+        return 1;
+    }
+    printf("OK\n");
+    return 0;
+}
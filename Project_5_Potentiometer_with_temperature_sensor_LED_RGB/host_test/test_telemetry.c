@@ -0,0 +1,167 @@
+// ===== GENERADOR DE TRAMAS PARA LA PRUEBA DEL DECODIFICADOR =====
+// Compila telemetry.c real con el anillo, la tarea y la UART sustituidos, envía
+// tramas cuyos campos contienen 0x0A, ejecuta telemetry_tx_task hasta vaciar el
+// anillo y vuelca a stdout exactamente los bytes que habrían llegado a la UART,
+// con líneas de log intercaladas. test_telemetry_decode.py los decodifica con
+// tools/telemetry_decode.py y compara con los valores enviados.
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <setjmp.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/ringbuf.h"
+#include "driver/uart.h"
+#include "driver/uart_vfs.h"
+#include "telemetry.h"
+
+#define RING_MAX_ITEMS      8
+#define UART_MAX_BYTES      1024
+
+// ===== SUSTITUTOS DEL ANILLO, LA TAREA Y LA UART =====
+static uint8_t ring_items[RING_MAX_ITEMS][sizeof(telemetry_frame_t)];
+static size_t ring_sizes[RING_MAX_ITEMS];
+static int ring_head = 0;
+static int ring_tail = 0;
+static int ring_token;              // Cualquier dirección no nula sirve de manejador
+
+static TaskFunction_t tx_task = NULL;
+static jmp_buf tx_task_exit;        // El anillo vacío termina la tarea (en la placa se bloquearía)
+
+static uint8_t uart_bytes[UART_MAX_BYTES];
+static size_t uart_length = 0;
+
+RingbufHandle_t xRingbufferCreate(size_t size, RingbufferType_t type)
+{
+    (void)size;
+    (void)type;
+    return &ring_token;
+}
+
+BaseType_t xRingbufferSend(RingbufHandle_t ring, const void *item, size_t size, TickType_t ticks)
+{
+    (void)ring;
+    (void)ticks;
+    if (ring_tail - ring_head >= RING_MAX_ITEMS || size > sizeof(ring_items[0])) {
+        return pdFALSE;
+    }
+    memcpy(ring_items[ring_tail % RING_MAX_ITEMS], item, size);
+    ring_sizes[ring_tail % RING_MAX_ITEMS] = size;
+    ring_tail++;
+    return pdTRUE;
+}
+
+void *xRingbufferReceive(RingbufHandle_t ring, size_t *size, TickType_t ticks)
+{
+    (void)ring;
+    if (ring_head == ring_tail) {
+        if (ticks == portMAX_DELAY) {
+            longjmp(tx_task_exit, 1);
+        }
+        return NULL;
+    }
+    *size = ring_sizes[ring_head % RING_MAX_ITEMS];
+    return ring_items[ring_head++ % RING_MAX_ITEMS];
+}
+
+void vRingbufferReturnItem(RingbufHandle_t ring, void *item)
+{
+    (void)ring;
+    (void)item;
+}
+
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t task, const char *name, uint32_t stack_depth, void *arg,
+                                   UBaseType_t priority, TaskHandle_t *handle, BaseType_t core)
+{
+    (void)name;
+    (void)stack_depth;
+    (void)arg;
+    (void)priority;
+    (void)handle;
+    (void)core;
+    tx_task = task;
+    return pdPASS;
+}
+
+bool uart_is_driver_installed(uart_port_t uart_num)
+{
+    (void)uart_num;
+    return false;
+}
+
+esp_err_t uart_driver_install(uart_port_t uart_num, int rx_buffer_size, int tx_buffer_size, int queue_size,
+                              void *uart_queue, int intr_alloc_flags)
+{
+    (void)uart_num;
+    (void)rx_buffer_size;
+    (void)tx_buffer_size;
+    (void)queue_size;
+    (void)uart_queue;
+    (void)intr_alloc_flags;
+    return ESP_OK;
+}
+
+void uart_vfs_dev_use_driver(int uart_num)
+{
+    (void)uart_num;
+}
+
+int uart_write_bytes(uart_port_t uart_num, const void *src, size_t size)
+{
+    (void)uart_num;
+    if (uart_length + size > sizeof(uart_bytes)) {
+        return -1;
+    }
+    memcpy(uart_bytes + uart_length, src, size);
+    uart_length += size;
+    return (int)size;
+}
+
+// Simula una línea de log de otra tarea escrita por la VFS a través del mismo driver
+static void uart_log_line(const char *line)
+{
+    uart_write_bytes(0, line, strlen(line));
+}
+
+// Ejecuta la tarea de transmisión hasta que vacía el anillo
+static void run_tx_task(void)
+{
+    if (setjmp(tx_task_exit) == 0) {
+        tx_task(NULL);
+    }
+}
+
+// ===== TRAMAS DE PRUEBA =====
+// Deben coincidir con EXPECTED en test_telemetry_decode.py
+static const telemetry_frame_t test_frames[] = {
+    // pot_percent == 10: el caso que perdía todas las tramas con la conversión LF -> CRLF
+    { .timestamp_ms = 1000, .pot_mv = 330, .pot_percent = 10, .ntc_raw = 2048, .temperature_cc = 2500, .ntc_duty = 384 },
+    // Todos los campos llenos de 0x0A
+    { .timestamp_ms = 0x0A0A0A0A, .pot_mv = 0x0A0A, .pot_percent = 0x0A, .ntc_raw = 0x0A0A, .temperature_cc = 0x0A0A, .ntc_duty = 0x0A },
+    // Temperatura negativa y 0x0D sueltos
+    { .timestamp_ms = 0x0D0A0D0A, .pot_mv = 3300, .pot_percent = 100, .ntc_raw = 13, .temperature_cc = -1000, .ntc_duty = 0 },
+};
+
+int main(void)
+{
+    telemetry_init();
+    if (tx_task == NULL) {
+        fprintf(stderr, "FALLO: telemetry_init no creó la tarea de transmisión\n");
+        return 1;
+    }
+
+    uart_log_line("I (100) MAIN: log antes de las tramas\n");
+    for (size_t i = 0; i < sizeof(test_frames) / sizeof(test_frames[0]); i++) {
+        telemetry_frame_t frame = test_frames[i];
+        if (!telemetry_send(&frame)) {
+            fprintf(stderr, "FALLO: telemetry_send descartó la trama %zu\n", i);
+            return 1;
+        }
+        run_tx_task();
+        uart_log_line("I (200) MAIN: log entre tramas\n");
+    }
+
+    fwrite(uart_bytes, 1, uart_length, stdout);
+    return 0;
+}
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+"""Comprueba que las tramas con bytes 0x0A llegan intactas al decodificador.
+
+Ejecuta test_telemetry (telemetry.c real con la UART sustituida), decodifica
+su salida con tools/telemetry_decode.py y compara con los valores enviados.
+Además verifica que la misma salida pasada por la conversión LF -> CRLF de
+stdout pierde las tramas, es decir, que la prueba cubre ese fallo.
+
+Uso: test_telemetry_decode.py <ruta a test_telemetry>
+"""
+import os
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'tools'))
+import telemetry_decode  # noqa: E402
+
+# (seq, timestamp_ms, pot_mv, pot_percent, ntc_raw, temperature_cc, ntc_duty); debe coincidir con test_frames
+EXPECTED = [
+    (0, 1000, 330, 10, 2048, 2500, 384),
+    (1, 0x0A0A0A0A, 0x0A0A, 0x0A, 0x0A0A, 0x0A0A, 0x0A),
+    (2, 0x0D0A0D0A, 3300, 100, 13, -1000, 0),
+]
+
+
+def decode(data):
+    return list(telemetry_decode.frames([data]))
+
+
+def main():
+    data = subprocess.run([sys.argv[1]], check=True, stdout=subprocess.PIPE).stdout
+
+    decoded = decode(data)
+    if decoded != EXPECTED:
+        print(f'FALLO: se esperaba {EXPECTED}\n       se decodificó {decoded}')
+        return 1
+
+    translated = decode(data.replace(b'\n', b'\r\n'))
+    if translated == EXPECTED:
+        print('FALLO: las tramas no contienen 0x0A, la prueba no cubre la conversión LF -> CRLF')
+        return 1
+
+    print(f'telemetry: {len(decoded)} tramas con 0x0A decodificadas; con LF -> CRLF sólo {len(translated)}')
+    print('OK')
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
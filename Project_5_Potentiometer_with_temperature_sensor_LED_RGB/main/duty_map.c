@@ -0,0 +1,113 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "duty_map.h"
+#include "ntc_sensor.h"
+#include <math.h>
+#include <stddef.h>
+
+#define TEMP_MIN_Q16            Q16_CONST(TEMP_MIN)
+#define TEMP_MAX_Q16            Q16_CONST(TEMP_MAX)
+
+// Factor 255/100 en Q16.16 redondeado hacia arriba: 100% produce exactamente 255
+#define GREEN_DUTY_PER_PERCENT_Q16  ((GREEN_DUTY_MAX * Q16_ONE + 99) / 100)
+
+// ===== VARIABLES GLOBALES =====
+static q16_t ntc_lut_q16[NTC_LUT_SIZE];
+
+// ===== FUNCIONES DE LA TABLA DE CONVERSIÓN =====
+float ntc_beta_temperature(int raw_adc_value)
+{
+    float resistance = SERIES_RESISTOR * ((4095.0 / raw_adc_value) - 1.0);
+
+    float steinhart;
+    steinhart = resistance / NOMINAL_RESISTANCE;
+    steinhart = log(steinhart);
+    steinhart /= B_COEFFICIENT;
+    steinhart += 1.0 / (NOMINAL_TEMPERATURE + 273.15);
+    steinhart = 1.0 / steinhart;
+    return steinhart - 273.15;
+}
+
+void ntc_lut_build(void)
+{
+    for (int i = 0; i < NTC_LUT_SIZE; i++) {
+        int raw = i << NTC_LUT_SHIFT;
+        if (raw < 1) raw = 1;                       // Evita la división por cero
+        if (raw > ADC_RAW_MAX - 1) raw = ADC_RAW_MAX - 1;
+
+        float temperature_c = ntc_beta_temperature(raw);
+        if (temperature_c < NTC_LUT_TEMP_MIN_C) temperature_c = NTC_LUT_TEMP_MIN_C;
+        if (temperature_c > NTC_LUT_TEMP_MAX_C) temperature_c = NTC_LUT_TEMP_MAX_C;
+
+        ntc_lut_q16[i] = (q16_t)lroundf(temperature_c * Q16_ONE);
+    }
+}
+
+q16_t ntc_lut_lookup_q16(uint32_t raw)
+{
+    if (raw > ADC_RAW_MAX) raw = ADC_RAW_MAX;
+
+    uint32_t idx = raw >> NTC_LUT_SHIFT;
+    int32_t frac = (int32_t)(raw & (NTC_LUT_STEP - 1));
+    q16_t t0 = ntc_lut_q16[idx];
+    q16_t t1 = ntc_lut_q16[idx + 1];
+
+    return t0 + (((t1 - t0) * frac) >> NTC_LUT_SHIFT);
+}
+
+// ===== FUNCIONES DE MAPEO TEMPERATURA -> BRILLO =====
+int ntc_map_duty_q16(q16_t temperature_c, q16_t *brightness_percent)
+{
+    q16_t brightness = 0;
+    int duty_cycle = 0;
+
+    if (temperature_c <= TEMP_MIN_Q16) {
+        brightness = 0;
+        duty_cycle = 0;
+    } else if (temperature_c >= TEMP_MAX_Q16) {
+        brightness = Q16_CONST(100.0);
+        duty_cycle = NTC_DUTY_MAX;
+    } else {
+        int64_t delta = temperature_c - TEMP_MIN_Q16;
+        int64_t span = TEMP_MAX_Q16 - TEMP_MIN_Q16;
+        brightness = (q16_t)((delta * 100 * Q16_ONE) / span);
+        duty_cycle = (int)((delta * NTC_DUTY_MAX) / span);
+    }
+
+    if (brightness_percent != NULL) {
+        *brightness_percent = brightness;
+    }
+    return duty_cycle;
+}
+
+int ntc_map_duty_float(float temperature_c, float *brightness_percent)
+{
+    float brightness = 0.0;
+    int duty_cycle = 0;
+
+    if (temperature_c <= TEMP_MIN) {
+        duty_cycle = 0;
+        brightness = 0.0;
+    } else if (temperature_c >= TEMP_MAX) {
+        duty_cycle = NTC_DUTY_MAX;
+        brightness = 100.0;
+    } else {
+        brightness = ((temperature_c - TEMP_MIN) / (TEMP_MAX - TEMP_MIN)) * 100.0;
+        duty_cycle = (int)(brightness * NTC_DUTY_MAX / 100.0);
+    }
+
+    if (brightness_percent != NULL) {
+        *brightness_percent = brightness;
+    }
+    return duty_cycle;
+}
+
+// ===== FUNCIONES DE MAPEO PORCENTAJE -> DUTY DEL LED VERDE =====
+uint32_t green_duty_q16(uint8_t percent)
+{
+    return ((uint32_t)percent * GREEN_DUTY_PER_PERCENT_Q16) >> Q16_SHIFT;
+}
+
+uint32_t green_duty_div(uint8_t percent)
+{
+    return ((uint32_t)percent * GREEN_DUTY_MAX) / 100;
+}
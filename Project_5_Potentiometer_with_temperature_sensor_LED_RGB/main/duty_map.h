@@ -0,0 +1,40 @@
+#ifndef DUTY_MAP_H
+#define DUTY_MAP_H
+
+#include <stdint.h>
+#include "fixed_q16.h"
+
+// Conversión sensor -> duty sin dependencias de ESP-IDF: la comparten
+// ntc_sensor.c, rgb_led.c y las pruebas de host_test.
+
+// ===== TABLA RAW -> TEMPERATURA DE LA NTC =====
+// Un nodo cada NTC_LUT_STEP códigos del ADC de 12 bits, temperatura en Q16.16
+#define ADC_RAW_MAX             4095
+#define NTC_LUT_SHIFT           5
+#define NTC_LUT_STEP            (1 << NTC_LUT_SHIFT)
+#define NTC_LUT_SIZE            (((ADC_RAW_MAX + 1) >> NTC_LUT_SHIFT) + 1)
+#define NTC_LUT_TEMP_MIN_C      (-55.0)  // Fuera de este rango el modelo Beta no es fiable
+#define NTC_LUT_TEMP_MAX_C      150.0
+
+// ===== RANGOS DE DUTY =====
+#define NTC_DUTY_MAX            1023    // LED rojo: LEDC de 10 bits (ntc_sensor.h, LEDC_DUTY_RES)
+#define GREEN_DUTY_MAX          255     // LED verde: LEDC de 8 bits (rgb_led.c, LEDC_DUTY_RES)
+
+// Ecuación Beta de referencia; sólo se usa al construir la tabla y en los benchmarks
+float ntc_beta_temperature(int raw_adc_value);
+
+// Rellena la tabla desde la ecuación Beta (una vez, al iniciar)
+void ntc_lut_build(void);
+
+// Interpolación lineal en punto fijo entre dos nodos consecutivos
+q16_t ntc_lut_lookup_q16(uint32_t raw);
+
+// Mapeo TEMP_MIN..TEMP_MAX -> 0..NTC_DUTY_MAX; brightness_percent puede ser NULL
+int ntc_map_duty_q16(q16_t temperature_c, q16_t *brightness_percent);  // Sólo enteros
+int ntc_map_duty_float(float temperature_c, float *brightness_percent); // Camino original
+
+// Porcentaje del potenciómetro (0..100) -> 0..GREEN_DUTY_MAX
+uint32_t green_duty_q16(uint8_t percent);   // Multiplicación y desplazamiento Q16.16
+uint32_t green_duty_div(uint8_t percent);   // División entera original
+
+#endif // DUTY_MAP_H
@@ -0,0 +1,22 @@
+#ifndef FIXED_Q16_H
+#define FIXED_Q16_H
+
+#include <stdint.h>
+
+// Aritmética en punto fijo Q16.16 (16 bits enteros con signo, 16 fraccionarios)
+typedef int32_t q16_t;
+
+#define Q16_SHIFT       16
+#define Q16_ONE         (1 << Q16_SHIFT)
+
+// Sólo para constantes: el compilador la resuelve sin generar código en coma flotante
+#define Q16_CONST(x)    ((q16_t)((x) * 65536.0 + ((x) >= 0 ? 0.5 : -0.5)))
+
+// Convierte a décimas redondeando (p. ej. 23.46 -> 235), útil para imprimir sin float
+static inline int32_t q16_to_tenths(q16_t x)
+{
+    int64_t scaled = (int64_t)x * 10;
+    return (int32_t)((scaled + (x >= 0 ? Q16_ONE / 2 : -Q16_ONE / 2)) / Q16_ONE);
+}
+
+#endif // FIXED_Q16_H
@@ -0,0 +1,159 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "led_pwm.h"
+#include <string.h>
+#include "esp_log.h"
+#include "esp_attr.h"
+#include "freertos/semphr.h"
+#include "freertos/timers.h"
+#include "sdkconfig.h"
+
+static const char *TAG = "LED_PWM";
+
+#if CONFIG_P5_LED_FADE
+// Un fundido más largo que el periodo de muestreo bloquearía cada consigna
+// esperando al anterior (el rango de Kconfig ya lo impide; esto cubre un
+// sdkconfig editado a mano)
+_Static_assert(CONFIG_P5_LED_FADE_MS <= CONFIG_P5_POT_PERIOD_MS,
+               "CONFIG_P5_LED_FADE_MS supera el periodo de muestreo del potenciómetro");
+_Static_assert(CONFIG_P5_LED_FADE_MS <= CONFIG_P5_NTC_PERIOD_MS,
+               "CONFIG_P5_LED_FADE_MS supera el periodo de muestreo de la NTC");
+#endif
+
+// ===== VARIABLES GLOBALES =====
+static bool fade_installed = false;
+static SemaphoreHandle_t pwm_lock = NULL;
+static portMUX_TYPE latch_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// Lote pendiente de una ISR (lo consume la tarea de temporizadores)
+static portMUX_TYPE isr_lock = portMUX_INITIALIZER_UNLOCKED;
+static led_pwm_duty_t isr_batch[LED_PWM_MAX_BATCH];
+static size_t isr_batch_count = 0;
+static bool isr_batch_pending = false;
+
+// ===== FUNCIONES DE INICIALIZACIÓN =====
+// Se llama tras configurar cada canal; el servicio de fundido y el mutex se crean una vez.
+// El servicio se instala siempre: ledc_set_duty_and_update lo necesita aunque no se funda.
+// Cada recurso tiene su propia marca: si el mutex falla, la siguiente llamada no vuelve a
+// instalar el servicio (ledc_fade_func_install devolvería error y abortaría el arranque).
+void led_pwm_init(void)
+{
+    if (!fade_installed) {
+        ESP_ERROR_CHECK(ledc_fade_func_install(0));
+        fade_installed = true;
+#if CONFIG_P5_LED_FADE
+        ESP_LOGI(TAG, "Fundido por hardware activo (%d ms por transición)", CONFIG_P5_LED_FADE_MS);
+#endif
+    }
+    if (pwm_lock == NULL) {
+        pwm_lock = xSemaphoreCreateMutex();
+        if (pwm_lock == NULL) {
+            ESP_LOGE(TAG, "Error creando el mutex de escritura de duty");
+        }
+    }
+}
+
+// ===== FUNCIONES PÚBLICAS =====
+esp_err_t led_pwm_set_duty(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t duty)
+{
+#if CONFIG_P5_LED_FADE
+    // En el ESP32 un fundido nuevo espera a que termine el anterior del mismo
+    // canal, por eso CONFIG_P5_LED_FADE_MS no puede superar el periodo de muestreo.
+    // No se toma pwm_lock: ledc_set_fade_time_and_start programa y arranca el
+    // fundido bajo el cerrojo del propio canal, así que la espera sólo detiene a
+    // quien escribe ese canal y no a los demás LEDs ni al commit diferido de la ISR
+    esp_err_t ret = ledc_set_fade_time_and_start(speed_mode, channel, duty, CONFIG_P5_LED_FADE_MS,
+                                                 LEDC_FADE_NO_WAIT);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Error escribiendo duty en el canal %d: %s", channel, esp_err_to_name(ret));
+    }
+    return ret;
+#else
+    led_pwm_duty_t single = {
+        .speed_mode = speed_mode,
+        .channel = channel,
+        .duty = duty,
+    };
+    return led_pwm_commit(&single, 1);
+#endif
+}
+
+esp_err_t led_pwm_commit(const led_pwm_duty_t *duties, size_t count)
+{
+    esp_err_t ret = ESP_OK;
+
+    if (duties == NULL || count == 0 || count > LED_PWM_MAX_BATCH) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (pwm_lock == NULL) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    xSemaphoreTake(pwm_lock, portMAX_DELAY);
+    if (count == 1) {
+        ret = ledc_set_duty_and_update(duties[0].speed_mode, duties[0].channel, duties[0].duty, 0);
+    } else {
+        // Cargar primero todos los registros de duty (pueden bloquear en el fundido)...
+        for (size_t i = 0; i < count && ret == ESP_OK; i++) {
+            ret = ledc_set_duty(duties[i].speed_mode, duties[i].channel, duties[i].duty);
+        }
+        // ...y enclavarlos seguidos, sin que ninguna tarea ni interrupción se intercale
+        if (ret == ESP_OK) {
+            taskENTER_CRITICAL(&latch_lock);
+            for (size_t i = 0; i < count; i++) {
+                ledc_update_duty(duties[i].speed_mode, duties[i].channel);
+            }
+            taskEXIT_CRITICAL(&latch_lock);
+        }
+    }
+    xSemaphoreGive(pwm_lock);
+
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Error aplicando lote de %u canales: %s", (unsigned)count, esp_err_to_name(ret));
+    }
+    return ret;
+}
+
+// Se ejecuta en la tarea de temporizadores de FreeRTOS
+static void led_pwm_commit_deferred(void *arg1, uint32_t arg2)
+{
+    led_pwm_duty_t batch[LED_PWM_MAX_BATCH];
+    size_t count;
+
+    taskENTER_CRITICAL(&isr_lock);
+    count = isr_batch_count;
+    memcpy(batch, isr_batch, count * sizeof(batch[0]));
+    isr_batch_pending = false;
+    taskEXIT_CRITICAL(&isr_lock);
+
+    led_pwm_commit(batch, count);
+}
+
+esp_err_t IRAM_ATTR led_pwm_commit_from_isr(const led_pwm_duty_t *duties, size_t count,
+                                            BaseType_t *higher_priority_task_woken)
+{
+    bool must_pend;
+
+    if (duties == NULL || count == 0 || count > LED_PWM_MAX_BATCH) {
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    taskENTER_CRITICAL_ISR(&isr_lock);
+    for (size_t i = 0; i < count; i++) {
+        isr_batch[i] = duties[i];
+    }
+    isr_batch_count = count;
+    must_pend = !isr_batch_pending;
+    isr_batch_pending = true;
+    taskEXIT_CRITICAL_ISR(&isr_lock);
+
+    // Un único aviso por lote pendiente: las ISR seguidas sólo actualizan los valores
+    if (must_pend && xTimerPendFunctionCallFromISR(led_pwm_commit_deferred, NULL, 0,
+                                                   higher_priority_task_woken) != pdPASS) {
+        taskENTER_CRITICAL_ISR(&isr_lock);
+        isr_batch_pending = false;
+        taskEXIT_CRITICAL_ISR(&isr_lock);
+        return ESP_ERR_TIMEOUT;
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,40 @@
+#ifndef LED_PWM_H
+#define LED_PWM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "driver/ledc.h"
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+
+// Escritura de duty común a todos los LEDs. Con CONFIG_P5_LED_FADE la
+// transición la ejecuta el fundido por hardware del LEDC en
+// CONFIG_P5_LED_FADE_MS: la CPU emite un único comando por consigna y cada
+// canal funde de forma independiente.
+//
+// Los lotes de led_pwm_commit pasan por un mutex, de modo que dos tareas que
+// escriben canales del mismo temporizador no intercalan sus llamadas. Los
+// fundidos no lo toman: el driver los serializa por canal.
+
+#define LED_PWM_MAX_BATCH       4       // Canales que admite un lote
+
+typedef struct {
+    ledc_mode_t speed_mode;
+    ledc_channel_t channel;
+    uint32_t duty;
+} led_pwm_duty_t;
+
+void led_pwm_init(void);
+esp_err_t led_pwm_set_duty(ledc_mode_t speed_mode, ledc_channel_t channel, uint32_t duty);
+
+// Aplica un lote de duty sin fundido: se cargan todos los canales y después se
+// enclavan juntos dentro de una sección crítica (un único canal usa
+// ledc_set_duty_and_update)
+esp_err_t led_pwm_commit(const led_pwm_duty_t *duties, size_t count);
+
+// Variante para ISR: copia el lote y difiere el commit a la tarea de
+// temporizadores de FreeRTOS. Si ya había un lote pendiente se sustituye.
+esp_err_t led_pwm_commit_from_isr(const led_pwm_duty_t *duties, size_t count,
+                                  BaseType_t *higher_priority_task_woken);
+
+#endif // LED_PWM_H
@@ -0,0 +1,49 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "mailbox.h"
+#include <string.h>
+#include "freertos/task.h"
+
+// ===== FUNCIONES PÚBLICAS =====
+void mailbox_init(mailbox_t *mb, void *storage, size_t size)
+{
+    atomic_init(&mb->seq, 0);
+    portMUX_INITIALIZE(&mb->lock);
+    mb->data = storage;
+    mb->size = size;
+    memset(storage, 0, size);
+}
+
+void mailbox_publish(mailbox_t *mb, const void *value)
+{
+    // La sección crítica impide que un lector del mismo núcleo expropie al
+    // productor a mitad de escritura y quede esperando un número de secuencia impar
+    taskENTER_CRITICAL(&mb->lock);
+
+    unsigned seq = atomic_load_explicit(&mb->seq, memory_order_relaxed);
+    atomic_store_explicit(&mb->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+
+    memcpy(mb->data, value, mb->size);
+
+    atomic_store_explicit(&mb->seq, seq + 2, memory_order_release);
+
+    taskEXIT_CRITICAL(&mb->lock);
+}
+
+void mailbox_snapshot(mailbox_t *mb, void *out)
+{
+    unsigned before;
+    unsigned after;
+
+    // Reintentar sólo si la copia se solapó con una publicación en el otro núcleo
+    do {
+        before = atomic_load_explicit(&mb->seq, memory_order_acquire);
+        if (before & 1) {
+            continue;
+        }
+        memcpy(out, mb->data, mb->size);
+        atomic_thread_fence(memory_order_acquire);
+        after = atomic_load_explicit(&mb->seq, memory_order_relaxed);
+    } while ((before & 1) || before != after);
+}
+
@@ -0,0 +1,21 @@
+#ifndef MAILBOX_H
+#define MAILBOX_H
+
+#include <stddef.h>
+#include <stdatomic.h>
+#include "freertos/FreeRTOS.h"
+
+// Buzón "último valor" basado en seqlock: los productores publican y cualquier
+// número de consumidores toma una instantánea coherente sin bloquear al productor
+typedef struct {
+    atomic_uint seq;        // Par: dato estable; impar: escritura en curso
+    portMUX_TYPE lock;      // Sólo serializa productores y evita su expropiación
+    void *data;
+    size_t size;
+} mailbox_t;
+
+void mailbox_init(mailbox_t *mb, void *storage, size_t size);
+void mailbox_publish(mailbox_t *mb, const void *value);
+void mailbox_snapshot(mailbox_t *mb, void *out);
+
+#endif // MAILBOX_H
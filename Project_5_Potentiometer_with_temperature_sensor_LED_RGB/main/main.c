@@ -1,45 +1,100 @@
 // ===== INCLUDES Y CONFIGURACIÓN =====
 #include <stdio.h>
+#include <stdlib.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/queue.h"
 #include "esp_log.h"
+#include "esp_system.h"
+#include "esp_timer.h"
+#include "esp_adc/adc_oneshot.h"
 
 #include "potentiometer.h"
 #include "rgb_led.h"
 #include "ntc_sensor.h"
+#include "mailbox.h"
+#include "sys_stats.h"
+#include "period_monitor.h"
+#include "task_config.h"
+#include "telemetry.h"
+#include "sampler.h"
+#include "sensor_hal.h"
 
 static const char *TAG = "MAIN";
 
-// ===== ESTRUCTURAS DE DATOS Y VARIABLES GLOBALES =====
-typedef struct {
-    uint8_t pot_percent;
-    uint32_t pot_voltage_mv;
-} pot_data_t;
+// Adquisición continua de ADC1 compartida por todos los canales analógicos
+#define ADC_SCAN_FREQ_HZ        (20 * 1000)     // Mínimo soportado por el DMA del ESP32
+#define ADC_SCAN_FRAME_BYTES    1024            // 512 conversiones por trama (~25 ms)
+#define ADC_SCAN_RING_FRAMES    4               // Tramas que el driver puede acumular
+#define ADC_SCAN_TASK_STACK     4096
 
+// ===== ESTRUCTURAS DE DATOS Y VARIABLES GLOBALES =====
+#if CONFIG_P5_LED_ACTUATION_QUEUES
 static QueueHandle_t pot_queue = NULL;
 static QueueHandle_t ntc_queue = NULL;
-static pot_data_t current_pot_data = {0};
-static ntc_data_t current_ntc_data = {0};
+#elif CONFIG_P5_LED_ACTUATION_NOTIFY
+#define ACT_POT_BIT     (1 << 0)
+#define ACT_NTC_BIT     (1 << 1)
+static TaskHandle_t led_actuator_handle = NULL;
+#endif
+
+// Periodo real de las tareas de lectura (jitter de muestreo)
+static period_monitor_t pot_period;
+static period_monitor_t ntc_period;
+
+// Veces que una tarea de LED despierta para aplicar una consigna (cambios de contexto)
+static volatile uint32_t led_task_wakeups = 0;
+// Consignas entregadas por los productores: led_wakeups / led_setpoints = cambios de contexto extra por muestra
+static volatile uint32_t led_setpoints = 0;
+// Heap consumido por las colas y tareas propias del modo de actuación (medido al arrancar)
+static volatile uint32_t led_path_ram = 0;
+
+// Último valor de cada sensor para display_info_task (publicación sin bloqueo)
+static mailbox_t pot_mailbox;
+static mailbox_t ntc_mailbox;
+static pot_sample_t pot_mailbox_storage;
+static ntc_data_t ntc_mailbox_storage;
+
+// ===== ENTREGA DE CONSIGNAS A LOS LEDs =====
+static void pot_dispatch(const pot_sample_t *pot_data)
+{
+    led_setpoints++;
+#if CONFIG_P5_LED_ACTUATION_INLINE
+    rgb_set_green_percent(pot_data->percent);
+#elif CONFIG_P5_LED_ACTUATION_NOTIFY
+    xTaskNotify(led_actuator_handle, ACT_POT_BIT, eSetBits);
+#else
+    // Sólo importa la consigna más reciente: se sobrescribe sin bloquear
+    xQueueOverwrite(pot_queue, pot_data);
+#endif
+}
+
+static void ntc_dispatch(const ntc_data_t *ntc_data)
+{
+    led_setpoints++;
+#if CONFIG_P5_LED_ACTUATION_INLINE
+    ntc_update_led_brightness(ntc_data->duty_cycle);
+#elif CONFIG_P5_LED_ACTUATION_NOTIFY
+    xTaskNotify(led_actuator_handle, ACT_NTC_BIT, eSetBits);
+#else
+    xQueueOverwrite(ntc_queue, ntc_data);
+#endif
+}
 
 // ===== TAREAS DEL SISTEMA =====
 void pot_reading_task(void *arg)
 {
-    pot_data_t pot_data;
+    pot_sample_t pot_data;
     
     ESP_LOGI(TAG, "Tarea de lectura del potenciómetro iniciada");
     
     while (1) {
-        pot_data.pot_percent = pot_get_percent();
-        pot_data.pot_voltage_mv = pot_get_voltage_mv();
+        sampler_wait();
+        period_monitor_tick(&pot_period);
+        pot_data = pot_read();
         
-        current_pot_data = pot_data;
-        
-        if (xQueueSend(pot_queue, &pot_data, pdMS_TO_TICKS(100)) != pdTRUE) {
-            ESP_LOGW(TAG, "Error enviando datos del potenciómetro a la cola");
-        }
-        
-        vTaskDelay(pdMS_TO_TICKS(250));
+        mailbox_publish(&pot_mailbox, &pot_data);
+        pot_dispatch(&pot_data);
     }
 }
 
@@ -50,27 +105,29 @@ void ntc_reading_task(void *arg)
     ESP_LOGI(TAG, "Tarea de lectura del sensor NTC iniciada");
     
     while (1) {
+        sampler_wait();
+        period_monitor_tick(&ntc_period);
         ntc_data = ntc_read_temperature();
         
-        current_ntc_data = ntc_data;
-        
-        if (xQueueSend(ntc_queue, &ntc_data, pdMS_TO_TICKS(100)) != pdTRUE) {
-            ESP_LOGW(TAG, "Error enviando datos del sensor NTC a la cola");
+        mailbox_publish(&ntc_mailbox, &ntc_data);
+        // Una lectura retenida repite la consigna anterior: no hace falta despertar al LED
+        if (ntc_data.valid) {
+            ntc_dispatch(&ntc_data);
         }
-        
-        vTaskDelay(pdMS_TO_TICKS(2000));
     }
 }
 
+#if CONFIG_P5_LED_ACTUATION_QUEUES
 void rgb_control_task(void *arg)
 {
-    pot_data_t received_data;
+    pot_sample_t received_data;
     
     ESP_LOGI(TAG, "Tarea de control del LED verde iniciada");
     
     while (1) {
         if (xQueueReceive(pot_queue, &received_data, portMAX_DELAY) == pdTRUE) {
-            rgb_set_green_percent(received_data.pot_percent);
+            led_task_wakeups++;
+            rgb_set_green_percent(received_data.percent);
         }
     }
 }
@@ -83,24 +140,96 @@ void ntc_led_control_task(void *arg)
     
     while (1) {
         if (xQueueReceive(ntc_queue, &received_data, portMAX_DELAY) == pdTRUE) {
-            ntc_update_led_brightness(received_data.temperature_c);
+            led_task_wakeups++;
+            ntc_update_led_brightness(received_data.duty_cycle);
         }
     }
 }
+#endif
+
+#if CONFIG_P5_LED_ACTUATION_NOTIFY
+// Una única tarea actuadora para ambos LEDs; las consignas se leen de los buzones
+void led_actuator_task(void *arg)
+{
+    uint32_t events = 0;
+    pot_sample_t pot_data;
+    ntc_data_t ntc_data;
+    
+    ESP_LOGI(TAG, "Tarea actuadora de LEDs iniciada");
+    
+    while (1) {
+        xTaskNotifyWait(0, UINT32_MAX, &events, portMAX_DELAY);
+        led_task_wakeups++;
+        
+        if (events & ACT_POT_BIT) {
+            mailbox_snapshot(&pot_mailbox, &pot_data);
+            rgb_set_green_percent(pot_data.percent);
+        }
+        if (events & ACT_NTC_BIT) {
+            mailbox_snapshot(&ntc_mailbox, &ntc_data);
+            ntc_update_led_brightness(ntc_data.duty_cycle);
+        }
+    }
+}
+#endif
+
+#if CONFIG_P5_MONITOR_BINARY
+// Temperatura en centésimas de grado para la trama binaria
+static int16_t ntc_temperature_cc(const ntc_data_t *ntc_data)
+{
+#if CONFIG_P5_FIXED_POINT
+    int64_t scaled = (int64_t)ntc_data->temperature_c * 100;
+    return (int16_t)((scaled + (scaled >= 0 ? Q16_ONE / 2 : -Q16_ONE / 2)) / Q16_ONE);
+#else
+    float scaled = ntc_data->temperature_c * 100.0f;
+    return (int16_t)(scaled >= 0 ? scaled + 0.5f : scaled - 0.5f);
+#endif
+}
+#endif
 
 void display_info_task(void *arg)
 {
+    pot_sample_t current_pot_data;
+    ntc_data_t current_ntc_data;
+    
     ESP_LOGI(TAG, "Tarea de visualización iniciada");
     
     while (1) {
+        mailbox_snapshot(&pot_mailbox, &current_pot_data);
+        mailbox_snapshot(&ntc_mailbox, &current_ntc_data);
+        
+#if CONFIG_P5_MONITOR_BINARY
+        telemetry_frame_t frame = {
+            .timestamp_ms = (uint32_t)(esp_timer_get_time() / 1000),
+            .pot_mv = (uint16_t)current_pot_data.voltage_mv,
+            .pot_percent = current_pot_data.percent,
+            .ntc_raw = (uint16_t)current_ntc_data.raw_adc_value,
+            .temperature_cc = ntc_temperature_cc(&current_ntc_data),
+            .ntc_duty = (uint16_t)current_ntc_data.duty_cycle,
+        };
+        telemetry_send(&frame);
+#else
         printf("\n=== SISTEMA DE MONITOREO ===\n");
         printf("LED Verde: %d%% | Potenciómetro: %lu mV\n", 
-               current_pot_data.pot_percent, current_pot_data.pot_voltage_mv);
+               current_pot_data.percent, current_pot_data.voltage_mv);
+#if CONFIG_P5_FIXED_POINT
+        int32_t temp_tenths = q16_to_tenths(current_ntc_data.temperature_c);
+        int32_t bright_tenths = q16_to_tenths(current_ntc_data.brightness_percent);
+        printf("Temperatura: %s%ld.%ld°C | LED Rojo: %ld.%ld%% brillo\n",
+               temp_tenths < 0 ? "-" : "", labs(temp_tenths) / 10, labs(temp_tenths) % 10,
+               bright_tenths / 10, bright_tenths % 10);
+#else
         printf("Temperatura: %.1f°C | LED Rojo: %.1f%% brillo\n", 
                current_ntc_data.temperature_c, current_ntc_data.brightness_percent);
+#endif
+        if (!current_ntc_data.valid) {
+            printf("Aviso: fallo de lectura NTC, se muestra el último valor válido\n");
+        }
+        printf("Despertares de tareas LED: %lu de %lu consignas\n", led_task_wakeups, led_setpoints);
         printf("=============================\n\n");
+#endif
         
-        vTaskDelay(pdMS_TO_TICKS(1000));
+        vTaskDelay(pdMS_TO_TICKS(CONFIG_P5_MONITOR_PERIOD_MS));
     }
 }
 
@@ -115,18 +244,50 @@ void app_main(void)
     rgb_led_init();
     ntc_sensor_init();
     ntc_led_pwm_init();
+
+    // Los canales continuos ya están registrados: un único patrón DMA los recorre todos
+    sensor_hal_scan_config_t scan_config = {
+        .sample_freq_hz = ADC_SCAN_FREQ_HZ,
+        .frame_bytes = ADC_SCAN_FRAME_BYTES,
+        .ring_frames = ADC_SCAN_RING_FRAMES,
+        .task_stack = ADC_SCAN_TASK_STACK,
+        .task_priority = P5_PRIO_ADC,
+        .task_core = P5_CORE_RT,
+    };
+    TaskHandle_t adc_scan_handle = NULL;
+    ESP_ERROR_CHECK(sensor_hal_scan_start(&scan_config, &adc_scan_handle));
+    sys_stats_register_task(adc_scan_handle);
     
     ESP_LOGI(TAG, "Hardware inicializado correctamente");
     
+    uint32_t heap_before = esp_get_free_heap_size();
+    uint32_t led_heap_mark = heap_before;
+    
     // ===== CREACIÓN DE COLAS PARA COMUNICACIÓN =====
-    pot_queue = xQueueCreate(5, sizeof(pot_data_t));
-    ntc_queue = xQueueCreate(5, sizeof(ntc_data_t));
+#if CONFIG_P5_LED_ACTUATION_QUEUES
+    // Colas de longitud 1 usadas como buzón con xQueueOverwrite
+    pot_queue = xQueueCreate(1, sizeof(pot_sample_t));
+    ntc_queue = xQueueCreate(1, sizeof(ntc_data_t));
     
     if (pot_queue == NULL || ntc_queue == NULL) {
         ESP_LOGE(TAG, "Error creando las colas de comunicación");
         return;
     }
     ESP_LOGI(TAG, "Colas de comunicación creadas exitosamente");
+    led_path_ram += led_heap_mark - esp_get_free_heap_size();
+#endif
+    
+    mailbox_init(&pot_mailbox, &pot_mailbox_storage, sizeof(pot_mailbox_storage));
+    mailbox_init(&ntc_mailbox, &ntc_mailbox_storage, sizeof(ntc_mailbox_storage));
+    
+    period_monitor_init(&pot_period, CONFIG_P5_POT_PERIOD_MS);
+    period_monitor_init(&ntc_period, CONFIG_P5_NTC_PERIOD_MS);
+    sys_stats_register_period("pot", &pot_period);
+    sys_stats_register_period("ntc", &ntc_period);
+    
+#if CONFIG_P5_MONITOR_BINARY
+    telemetry_init();
+#endif
     
     // ===== PRUEBA INICIAL DE LOS LEDs =====
     ESP_LOGI(TAG, "Realizando prueba inicial de LEDs...");
@@ -134,40 +295,86 @@ void app_main(void)
     
     // ===== CREACIÓN DE TAREAS DEL SISTEMA =====
     ESP_LOGI(TAG, "Creando tareas del sistema...");
+    TaskHandle_t task_handle = NULL;
     
-    if (xTaskCreate(pot_reading_task, "pot_reading_task", 4096, NULL, 5, NULL) != pdPASS) {
+#if CONFIG_P5_LED_ACTUATION_NOTIFY
+    // La tarea actuadora debe existir antes de que los productores la notifiquen
+    led_heap_mark = esp_get_free_heap_size();
+    if (xTaskCreatePinnedToCore(led_actuator_task, "led_actuator_task", 4096, NULL, P5_PRIO_ACTUATOR,
+                                &led_actuator_handle, P5_CORE_RT) != pdPASS) {
+        ESP_LOGE(TAG, "Error creando tarea actuadora de LEDs");
+        return;
+    }
+    sys_stats_register_task(led_actuator_handle);
+    led_path_ram += led_heap_mark - esp_get_free_heap_size();
+    
+#endif
+    if (xTaskCreatePinnedToCore(pot_reading_task, "pot_reading_task", 4096, NULL, P5_PRIO_SENSOR,
+                                &task_handle, P5_CORE_RT) != pdPASS) {
         ESP_LOGE(TAG, "Error creando tarea de lectura del potenciómetro");
         return;
     }
+    sys_stats_register_task(task_handle);
+    ESP_ERROR_CHECK(sampler_register(task_handle, CONFIG_P5_POT_PERIOD_MS));
     
-    if (xTaskCreate(ntc_reading_task, "ntc_reading_task", 4096, NULL, 5, NULL) != pdPASS) {
+    if (xTaskCreatePinnedToCore(ntc_reading_task, "ntc_reading_task", 4096, NULL, P5_PRIO_SENSOR,
+                                &task_handle, P5_CORE_RT) != pdPASS) {
         ESP_LOGE(TAG, "Error creando tarea de lectura del sensor NTC");
         return;
     }
+    sys_stats_register_task(task_handle);
+    ESP_ERROR_CHECK(sampler_register(task_handle, CONFIG_P5_NTC_PERIOD_MS));
     
-    if (xTaskCreate(rgb_control_task, "rgb_control_task", 4096, NULL, 4, NULL) != pdPASS) {
+#if CONFIG_P5_LED_ACTUATION_QUEUES
+    led_heap_mark = esp_get_free_heap_size();
+    if (xTaskCreatePinnedToCore(rgb_control_task, "rgb_control_task", 4096, NULL, P5_PRIO_ACTUATOR,
+                                &task_handle, P5_CORE_RT) != pdPASS) {
         ESP_LOGE(TAG, "Error creando tarea de control del LED verde");
         return;
     }
+    sys_stats_register_task(task_handle);
     
-    if (xTaskCreate(ntc_led_control_task, "ntc_led_control_task", 4096, NULL, 4, NULL) != pdPASS) {
+    if (xTaskCreatePinnedToCore(ntc_led_control_task, "ntc_led_control_task", 4096, NULL, P5_PRIO_ACTUATOR,
+                                &task_handle, P5_CORE_RT) != pdPASS) {
         ESP_LOGE(TAG, "Error creando tarea de control del LED rojo");
         return;
     }
+    sys_stats_register_task(task_handle);
+    led_path_ram += led_heap_mark - esp_get_free_heap_size();
+#endif
     
-    if (xTaskCreate(display_info_task, "display_info_task", 4096, NULL, 3, NULL) != pdPASS) {
+    if (xTaskCreatePinnedToCore(display_info_task, "display_info_task", 4096, NULL, P5_PRIO_DISPLAY,
+                                &task_handle, P5_CORE_UI) != pdPASS) {
         ESP_LOGE(TAG, "Error creando tarea de visualización");
         return;
     }
+    sys_stats_register_task(task_handle);
+    
+    // ===== ARRANQUE DEL MUESTREO =====
+    ESP_ERROR_CHECK(sampler_start());
     
     // ===== SISTEMA INICIADO EXITOSAMENTE =====
     ESP_LOGI(TAG, "=== SISTEMA RTOS INICIADO EXITOSAMENTE ===");
+    ESP_LOGI(TAG, "RAM usada por colas y tareas: %lu bytes (actuación de LEDs: %lu bytes)",
+             heap_before - esp_get_free_heap_size(), led_path_ram);
+    
+    // Ahorro de cada modo de actuación: RAM del camino de LEDs y cambios de contexto por consigna
+    sys_stats_register_counter("led_ram", &led_path_ram);
+    sys_stats_register_counter("led_wakeups", &led_task_wakeups);
+    sys_stats_register_counter("led_setpoints", &led_setpoints);
+    sys_stats_start();
     ESP_LOGI(TAG, "Configuración del hardware:");
     ESP_LOGI(TAG, "  - Potenciómetro: ADC1 CH6 (GPIO34) -> LED Verde (GPIO27)");
-    ESP_LOGI(TAG, "  - Sensor NTC: ADC2 CH9 (GPIO26) -> LED Rojo (GPIO25)");
+    int ntc_gpio = -1;
+    adc_oneshot_channel_to_io(ADC_UNIT, NTC_PIN, &ntc_gpio);  // Con CONFIG_P5_ADC_SCAN la NTC pasa a ADC1
+    ESP_LOGI(TAG, "  - Sensor NTC: ADC%d CH%d (GPIO%d) -> LED Rojo (GPIO25)", ADC_UNIT + 1, NTC_PIN, ntc_gpio);
+#if CONFIG_P5_PIN_TASKS
+    ESP_LOGI(TAG, "Plan de núcleos: adquisición/actuación en CPU%d, monitor en CPU%d",
+             P5_CORE_RT, P5_CORE_UI);
+#endif
     ESP_LOGI(TAG, "Frecuencias de operación:");
-    ESP_LOGI(TAG, "  - Lectura potenciómetro: 4 veces/segundo");
-    ESP_LOGI(TAG, "  - Lectura sensor NTC: cada 2 segundos");
-    ESP_LOGI(TAG, "  - Monitor serie: cada 1 segundo");
+    ESP_LOGI(TAG, "  - Lectura potenciómetro: cada %d ms", CONFIG_P5_POT_PERIOD_MS);
+    ESP_LOGI(TAG, "  - Lectura sensor NTC: cada %d ms", CONFIG_P5_NTC_PERIOD_MS);
+    ESP_LOGI(TAG, "  - Monitor serie: cada %d ms", CONFIG_P5_MONITOR_PERIOD_MS);
     ESP_LOGI(TAG, "=== SISTEMA EN FUNCIONAMIENTO ===");
 }
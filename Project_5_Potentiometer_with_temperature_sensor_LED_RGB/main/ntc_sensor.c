@@ -1,87 +1,114 @@
 // ===== INCLUDES Y CONFIGURACIÓN =====
 #include "ntc_sensor.h"
 #include "esp_log.h"
-#include "esp_adc/adc_oneshot.h"
-#include "esp_adc/adc_cali.h"
-#include "esp_adc/adc_cali_scheme.h"
+#include "sensor_hal.h"
 #include "driver/ledc.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "esp_cpu.h"
+#include "sdkconfig.h"
+#include "adc_filter.h"
+#include "sys_stats.h"
+#include "led_pwm.h"
+#include "duty_map.h"
 #include <math.h>
 
 static const char *TAG = "NTC_TEMP_CONTROL";
 
+// ===== CONFIGURACIÓN DEL FILTRADO =====
+#define NTC_BURST_SAMPLES       5       // Lecturas por ciclo; la mediana descarta picos
+#define NTC_IIR_SHIFT           1       // Suavizado entre ciclos (la NTC es lenta)
+#define NTC_RETRY_BUDGET        3       // Lecturas fallidas toleradas por ciclo antes de retener
+
+// duty_map.c no depende del driver LEDC: su rango debe coincidir con la resolución configurada
+_Static_assert(NTC_DUTY_MAX == (1 << LEDC_DUTY_RES) - 1, "NTC_DUTY_MAX no coincide con LEDC_DUTY_RES");
+
 // ===== VARIABLES GLOBALES =====
-static adc_oneshot_unit_handle_t adc2_handle;
-static adc_cali_handle_t adc2_cali_handle = NULL;
+// Contadores de errores exportados a sys_stats (sólo los escribe ntc_reading_task)
+static volatile uint32_t ntc_err_adc = 0;       // Conversiones fallidas (p. ej. ADC2 ocupado por Wi-Fi)
+static volatile uint32_t ntc_err_range = 0;     // Lecturas en 0 o fondo de escala (NTC abierta o en corto)
+static volatile uint32_t ntc_err_held = 0;      // Ciclos en los que se retuvo la última lectura válida
+
+static sensor_hal_channel_t ntc_hal_channel;
+static adc_filter_median_t ntc_median;
+static adc_filter_iir_t ntc_iir;
+static ntc_data_t last_good;    // Última lectura válida; se entrega mientras el ADC falla
+static int applied_duty = 0;    // Último duty escrito en el LEDC (el canal arranca en 0)
 
-// ===== FUNCIONES DE CALIBRACIÓN DEL ADC =====
-static bool adc_calibration_init(adc_unit_t unit, adc_atten_t atten, adc_cali_handle_t *out_handle)
+// ===== BENCHMARK DE LA TABLA DE CONVERSIÓN =====
+#if CONFIG_P5_NTC_LUT_BENCHMARK
+// Compara tabla y ecuación Beta: ciclos en todo el ADC, error en TEMP_MIN..TEMP_MAX
+static void ntc_lut_benchmark(void)
 {
-    adc_cali_handle_t handle = NULL;
-    esp_err_t ret = ESP_FAIL;
-    bool calibrated = false;
-
-#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
-    if (!calibrated) {
-        ESP_LOGI(TAG, "Calibración por curve fitting");
-        adc_cali_curve_fitting_config_t cali_config = {
-            .unit_id = unit,
-            .atten = atten,
-            .bitwidth = ADC_BITWIDTH_DEFAULT,
-        };
-        ret = adc_cali_create_scheme_curve_fitting(&cali_config, &handle);
-        if (ret == ESP_OK) {
-            calibrated = true;
-        }
+    volatile float sink_f = 0;
+    volatile int32_t sink_q = 0;
+    float max_err = 0;
+    int max_err_raw = 0;
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (int raw = 1; raw < ADC_RAW_MAX; raw++) {
+        sink_f = ntc_beta_temperature(raw);
     }
-#endif
+    uint32_t beta_cycles = esp_cpu_get_cycle_count() - start;
 
-#if ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
-    if (!calibrated) {
-        ESP_LOGI(TAG, "Calibración por line fitting");
-        adc_cali_line_fitting_config_t cali_config = {
-            .unit_id = unit,
-            .atten = atten,
-            .bitwidth = ADC_BITWIDTH_DEFAULT,
-        };
-        ret = adc_cali_create_scheme_line_fitting(&cali_config, &handle);
-        if (ret == ESP_OK) {
-            calibrated = true;
-        }
+    start = esp_cpu_get_cycle_count();
+    for (int raw = 1; raw < ADC_RAW_MAX; raw++) {
+        sink_q = ntc_lut_lookup_q16(raw);
     }
-#endif
+    uint32_t lut_cycles = esp_cpu_get_cycle_count() - start;
 
-    *out_handle = handle;
-    if (ret == ESP_OK) {
-        ESP_LOGI(TAG, "Calibración exitosa");
-    } else if (ret == ESP_ERR_NOT_SUPPORTED || !calibrated) {
-        ESP_LOGW(TAG, "Calibración no soportada, use valores sin calibrar");
-    } else {
-        ESP_LOGE(TAG, "Fallo en la calibración");
+    for (int raw = 1; raw < ADC_RAW_MAX; raw++) {
+        float ref = ntc_beta_temperature(raw);
+        if (ref < TEMP_MIN || ref > TEMP_MAX) {
+            continue;
+        }
+        float err = fabsf(ref - (float)ntc_lut_lookup_q16(raw) / Q16_ONE);
+        if (err > max_err) {
+            max_err = err;
+            max_err_raw = raw;
+        }
     }
+    (void)sink_f;
+    (void)sink_q;
 
-    return calibrated;
+    ESP_LOGI(TAG, "Benchmark NTC: Beta %lu ciclos/muestra, tabla %lu ciclos/muestra",
+             (unsigned long)(beta_cycles / (ADC_RAW_MAX - 1)),
+             (unsigned long)(lut_cycles / (ADC_RAW_MAX - 1)));
+    ESP_LOGI(TAG, "Benchmark NTC: error máximo %.3f°C en raw=%d (rango %.0f..%.0f°C)",
+             max_err, max_err_raw, TEMP_MIN, TEMP_MAX);
 }
+#endif
 
 // ===== FUNCIONES DE INICIALIZACIÓN =====
 void ntc_sensor_init(void) {
-    ESP_LOGI(TAG, "Inicializando ADC2 para sensor NTC...");
+    ESP_LOGI(TAG, "Inicializando ADC%d para sensor NTC...", ADC_UNIT + 1);
     
-    adc_oneshot_unit_init_cfg_t init_config1 = {
-        .unit_id = ADC_UNIT,
-    };
-    ESP_ERROR_CHECK(adc_oneshot_new_unit(&init_config1, &adc2_handle));
-
-    adc_oneshot_chan_cfg_t config = {
-        .bitwidth = ADC_BITWIDTH_DEFAULT,
+    sensor_hal_channel_config_t hal_config = {
+        .name = "ntc",
+        .unit = ADC_UNIT,
+        .channel = NTC_PIN,
         .atten = ADC_ATTEN_DB_12,
+#if CONFIG_P5_ADC_SCAN
+        .mode = SENSOR_HAL_MODE_CONTINUOUS,
+#else
+        .mode = SENSOR_HAL_MODE_ONESHOT,
+#endif
     };
-    ESP_ERROR_CHECK(adc_oneshot_config_channel(adc2_handle, NTC_PIN, &config));
+    ESP_ERROR_CHECK(sensor_hal_channel_register(&hal_config, &ntc_hal_channel));
+
+    adc_filter_median_init(&ntc_median, NTC_BURST_SAMPLES);
+    adc_filter_iir_init(&ntc_iir, NTC_IIR_SHIFT);
 
-    adc_calibration_init(ADC_UNIT, ADC_ATTEN_DB_12, &adc2_cali_handle);
+    sys_stats_register_counter("ntc_err_adc", &ntc_err_adc);
+    sys_stats_register_counter("ntc_err_range", &ntc_err_range);
+    sys_stats_register_counter("ntc_err_held", &ntc_err_held);
+
+    ntc_lut_build();
+#if CONFIG_P5_NTC_LUT_BENCHMARK
+    ntc_lut_benchmark();
+#endif
     
-    ESP_LOGI(TAG, "ADC2 inicializado correctamente en GPIO26 (ADC_CHANNEL_9)");
+    ESP_LOGI(TAG, "NTC registrado en ADC%d_CH%d", ADC_UNIT + 1, NTC_PIN);
 }
 
 void ntc_led_pwm_init(void) {
@@ -106,71 +133,114 @@ void ntc_led_pwm_init(void) {
         .hpoint         = 0
     };
     ESP_ERROR_CHECK(ledc_channel_config(&ledc_channel));
+    led_pwm_init();
     
     ESP_LOGI(TAG, "PWM del LED rojo inicializado en GPIO %d (10-bit, 5kHz)", LED_PIN);
 }
 
+// ===== FUNCIONES DE MAPEO TEMPERATURA -> BRILLO =====
+// Implementadas en duty_map.c; host_test/test_duty_map.c comprueba que ambos caminos coinciden a ±1 LSB
+#if CONFIG_P5_FIXED_POINT
+#define ntc_map_duty ntc_map_duty_q16
+#else
+#define ntc_map_duty ntc_map_duty_float
+#endif
+
 // ===== FUNCIONES DE LECTURA Y CÁLCULO =====
+// Ráfaga de lecturas -> mediana (rechazo de picos) -> IIR entre ciclos
+static esp_err_t ntc_read_filtered_raw(int *out_raw)
+{
+    uint32_t median = 0;
+    int failures = 0;
+
+#if CONFIG_P5_ADC_SCAN
+    // En modo escaneo la ráfaga son las últimas tramas ya promediadas por el DMA
+    uint16_t recent[NTC_BURST_SAMPLES];
+    size_t n = 0;
+    while ((n = sensor_hal_scan_read(ntc_hal_channel, recent, NTC_BURST_SAMPLES)) == 0) {
+        ntc_err_adc++;
+        if (++failures >= NTC_RETRY_BUDGET) {
+            return ESP_ERR_INVALID_STATE;
+        }
+        vTaskDelay(1);
+    }
+    for (size_t i = n; i > 0; i--) {
+        median = adc_filter_median_update(&ntc_median, recent[i - 1]);
+    }
+#else
+    int accepted = 0;
+    while (accepted < NTC_BURST_SAMPLES) {
+        int raw = 0;
+        esp_err_t result = sensor_hal_read_raw(ntc_hal_channel, &raw);
+        if (result != ESP_OK) {
+            // ADC2 puede estar tomado por el Wi-Fi: ceder un tick y reintentar dentro del presupuesto
+            ntc_err_adc++;
+            if (++failures >= NTC_RETRY_BUDGET) {
+                return result;
+            }
+            vTaskDelay(1);
+            continue;
+        }
+        median = adc_filter_median_update(&ntc_median, (uint32_t)raw);
+        accepted++;
+    }
+#endif
+
+    *out_raw = (int)adc_filter_iir_update(&ntc_iir, median);
+    return ESP_OK;
+}
+
+// Si la lectura falla se entrega la última válida con valid = false, de modo
+// que un bloqueo transitorio del ADC nunca lleva el LED a 0%
 ntc_data_t ntc_read_temperature(void) {
     ntc_data_t ntc_data = {0};
     int raw_adc_value;
     
-    esp_err_t result = adc_oneshot_read(adc2_handle, NTC_PIN, &raw_adc_value);
+    esp_err_t result = ntc_read_filtered_raw(&raw_adc_value);
+
+    if (result == ESP_OK && (raw_adc_value <= 0 || raw_adc_value >= ADC_RAW_MAX)) {
+        // Fuera de rango la resistencia no está definida (división por cero en raw = 0)
+        ntc_err_range++;
+        result = ESP_ERR_INVALID_RESPONSE;
+    }
 
     if (result == ESP_OK) {
         ntc_data.raw_adc_value = raw_adc_value;
         
+#if CONFIG_P5_FIXED_POINT
+        ntc_data.resistance = ((uint32_t)SERIES_RESISTOR * (ADC_RAW_MAX - raw_adc_value)) / raw_adc_value;
+        ntc_data.temperature_c = ntc_lut_lookup_q16(raw_adc_value);
+#else
         float resistance = SERIES_RESISTOR * ((4095.0 / raw_adc_value) - 1.0);
         ntc_data.resistance = resistance;
 
-        float steinhart;
-        steinhart = resistance / NOMINAL_RESISTANCE;
-        steinhart = log(steinhart);
-        steinhart /= B_COEFFICIENT;
-        steinhart += 1.0 / (NOMINAL_TEMPERATURE + 273.15);
-        steinhart = 1.0 / steinhart;
-        float temperature_c = steinhart - 273.15;
-        ntc_data.temperature_c = temperature_c;
-
-        int duty_cycle = 0;
-        float brightness_percent = 0.0;
-        
-        if (temperature_c <= TEMP_MIN) {
-            duty_cycle = 0;
-            brightness_percent = 0.0;
-        } else if (temperature_c >= TEMP_MAX) {
-            duty_cycle = (1 << LEDC_DUTY_RES) - 1;
-            brightness_percent = 100.0;
-        } else {
-            brightness_percent = ((temperature_c - TEMP_MIN) / (TEMP_MAX - TEMP_MIN)) * 100.0;
-            duty_cycle = (int)(brightness_percent * ((1 << LEDC_DUTY_RES) - 1) / 100.0);
-        }
-        
-        ntc_data.brightness_percent = brightness_percent;
-        ntc_data.duty_cycle = duty_cycle;
+        ntc_data.temperature_c = (float)ntc_lut_lookup_q16(raw_adc_value) / Q16_ONE;
+#endif
+
+        ntc_data.duty_cycle = ntc_map_duty(ntc_data.temperature_c, &ntc_data.brightness_percent);
+        ntc_data.valid = true;
+        last_good = ntc_data;
 
     } else {
-        ESP_LOGE(TAG, "Error al leer ADC2: %s", esp_err_to_name(result));
+        ntc_err_held++;
+        ESP_LOGW(TAG, "Lectura NTC fallida (%s), se retiene la última válida", esp_err_to_name(result));
+        ntc_data = last_good;
+        ntc_data.valid = false;
     }
 
     return ntc_data;
 }
 
 // ===== FUNCIONES DE CONTROL DEL LED =====
-void ntc_update_led_brightness(float temperature_c) {
-    int duty_cycle = 0;
-    
-    if (temperature_c <= TEMP_MIN) {
-        duty_cycle = 0;
-    } else if (temperature_c >= TEMP_MAX) {
-        duty_cycle = (1 << LEDC_DUTY_RES) - 1;
-    } else {
-        float brightness_percent = ((temperature_c - TEMP_MIN) / (TEMP_MAX - TEMP_MIN)) * 100.0;
-        duty_cycle = (int)(brightness_percent * ((1 << LEDC_DUTY_RES) - 1) / 100.0);
+void ntc_update_led_brightness(int duty_cycle) {
+    // Si el duty no cambia no se toca el periférico
+    if (duty_cycle == applied_duty) {
+        return;
     }
 
-    ESP_ERROR_CHECK(ledc_set_duty(LEDC_MODE, LEDC_CHANNEL, duty_cycle));
-    ESP_ERROR_CHECK(ledc_update_duty(LEDC_MODE, LEDC_CHANNEL));
+    if (led_pwm_set_duty(LEDC_MODE, LEDC_CHANNEL, duty_cycle) == ESP_OK) {
+        applied_duty = duty_cycle;
+    }
 }
 
 void ntc_test_led(void) {
@@ -182,6 +252,7 @@ void ntc_test_led(void) {
     
     ESP_ERROR_CHECK(ledc_set_duty(LEDC_MODE, LEDC_CHANNEL, 0));
     ESP_ERROR_CHECK(ledc_update_duty(LEDC_MODE, LEDC_CHANNEL));
+    applied_duty = 0;
     
     ESP_LOGI(TAG, "Prueba del LED rojo completada exitosamente");
 }
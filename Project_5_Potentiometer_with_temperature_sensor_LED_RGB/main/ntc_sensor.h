@@ -2,11 +2,23 @@
 #define NTC_SENSOR_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include "sdkconfig.h"
+#include "fixed_q16.h"
 
 // --- Configuración de Pines ---
+#if CONFIG_P5_ADC_SCAN
+// En modo escaneo la NTC se mueve a ADC1 para compartir el patrón DMA con el potenciómetro
+#define NTC_PIN         CONFIG_P5_ADC_SCAN_NTC_CHANNEL  // ADC1_CH7 es GPIO35
+#define ADC_UNIT        ADC_UNIT_1
+#if CONFIG_P5_ADC_SCAN_NTC_CHANNEL == 6
+#error "ADC1_CH6 (GPIO34) ya lo usa el potenciómetro"
+#endif
+#else
 #define NTC_PIN         ADC_CHANNEL_9   // GPIO26 es ADC_CHANNEL_9
-#define LED_PIN         25              // LED rojo de temperatura en GPIO25
 #define ADC_UNIT        ADC_UNIT_2
+#endif
+#define LED_PIN         25              // LED rojo de temperatura en GPIO25
 
 // --- Constantes del Termistor NTC 10k ---
 #define NOMINAL_RESISTANCE      10000.0 // Resistencia nominal a 25°C
@@ -25,20 +37,32 @@
 #define TEMP_MIN                10.0 // Temperatura a 0% de brillo
 #define TEMP_MAX                50.0 // Temperatura a 100% de brillo
 
+// Magnitudes reales: Q16.16 en el modo punto fijo, float en el modo normal
+#if CONFIG_P5_FIXED_POINT
+typedef q16_t ntc_real_t;
+#else
+typedef float ntc_real_t;
+#endif
+
 // Estructura para datos del sensor NTC
 typedef struct {
-    float temperature_c;
+    ntc_real_t temperature_c;
+#if CONFIG_P5_FIXED_POINT
+    uint32_t resistance;            // Ohmios enteros
+#else
     float resistance;
+#endif
     int raw_adc_value;
-    float brightness_percent;
+    ntc_real_t brightness_percent;
     int duty_cycle;
+    bool valid;                     // false: lectura fallida, los campos son la última válida
 } ntc_data_t;
 
 // Funciones públicas
 void ntc_sensor_init(void);
 void ntc_led_pwm_init(void);
 ntc_data_t ntc_read_temperature(void);
-void ntc_update_led_brightness(float temperature_c);
+void ntc_update_led_brightness(int duty_cycle); // aplica ntc_data_t.duty_cycle; no escribe si no cambia
 void ntc_test_led(void);
 
 #endif // NTC_SENSOR_H
@@ -0,0 +1,91 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "period_monitor.h"
+#include <string.h>
+#include "freertos/task.h"
+#include "esp_timer.h"
+
+static const uint32_t hist_limits_us[PERIOD_HIST_BINS] = PERIOD_HIST_LIMITS_US;
+
+// ===== FUNCIONES AUXILIARES =====
+static uint32_t isqrt64(uint64_t value)
+{
+    uint64_t result = 0;
+    uint64_t bit = 1ULL << 62;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= result + bit) {
+            value -= result + bit;
+            result = (result >> 1) + bit;
+        } else {
+            result >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)result;
+}
+
+// ===== FUNCIONES PÚBLICAS =====
+void period_monitor_init(period_monitor_t *pm, uint32_t nominal_ms)
+{
+    memset(pm, 0, sizeof(*pm));
+    portMUX_INITIALIZE(&pm->lock);
+    pm->nominal_us = nominal_ms * 1000;
+    pm->min_us = UINT32_MAX;
+}
+
+void period_monitor_tick(period_monitor_t *pm)
+{
+    int64_t now = esp_timer_get_time();
+
+    taskENTER_CRITICAL(&pm->lock);
+    if (pm->last_us != 0) {
+        uint32_t period = (uint32_t)(now - pm->last_us);
+        int64_t dev = (int64_t)period - pm->nominal_us;
+
+        pm->count++;
+        if (period < pm->min_us) pm->min_us = period;
+        if (period > pm->max_us) pm->max_us = period;
+        pm->sum_dev_us += dev;
+        pm->sum_dev_sq_us += (uint64_t)(dev * dev);
+
+        uint32_t abs_dev = (uint32_t)(dev < 0 ? -dev : dev);
+        int bin = 0;
+        while (abs_dev > hist_limits_us[bin]) {
+            bin++;
+        }
+        pm->hist[bin]++;
+    }
+    pm->last_us = now;
+    taskEXIT_CRITICAL(&pm->lock);
+}
+
+period_summary_t period_monitor_summary(period_monitor_t *pm)
+{
+    period_summary_t summary = {0};
+
+    taskENTER_CRITICAL(&pm->lock);
+    uint32_t count = pm->count;
+    int64_t sum_dev = pm->sum_dev_us;
+    uint64_t sum_dev_sq = pm->sum_dev_sq_us;
+    summary.min_us = pm->min_us;
+    summary.max_us = pm->max_us;
+    memcpy(summary.hist, pm->hist, sizeof(summary.hist));
+    taskEXIT_CRITICAL(&pm->lock);
+
+    summary.count = count;
+    if (count == 0) {
+        summary.min_us = 0;
+        return summary;
+    }
+
+    // Varianza = E[d^2] - E[d]^2, con d la desviación respecto al periodo nominal
+    int64_t mean_dev = sum_dev / count;
+    uint64_t mean_sq = sum_dev_sq / count;
+    uint64_t mean_dev_sq = (uint64_t)(mean_dev * mean_dev);
+    summary.mean_us = (uint32_t)(pm->nominal_us + mean_dev);
+    summary.stddev_us = isqrt64(mean_sq > mean_dev_sq ? mean_sq - mean_dev_sq : 0);
+    return summary;
+}
@@ -0,0 +1,39 @@
+#ifndef PERIOD_MONITOR_H
+#define PERIOD_MONITOR_H
+
+#include <stdint.h>
+#include "freertos/FreeRTOS.h"
+
+// Histograma de |periodo - nominal|: límites superiores en µs de cada clase;
+// la última clase recoge todas las desviaciones mayores
+#define PERIOD_HIST_BINS        8
+#define PERIOD_HIST_LIMITS_US   { 50, 100, 200, 500, 1000, 2000, 5000, UINT32_MAX }
+
+// Mide el periodo real de una tarea periódica y su desviación respecto al nominal
+typedef struct {
+    portMUX_TYPE lock;
+    uint32_t nominal_us;
+    int64_t last_us;
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    int64_t sum_dev_us;         // Suma de (periodo - nominal)
+    uint64_t sum_dev_sq_us;     // Suma de (periodo - nominal)^2
+    uint32_t hist[PERIOD_HIST_BINS];
+} period_monitor_t;
+
+// Resumen coherente para informar
+typedef struct {
+    uint32_t count;
+    uint32_t min_us;
+    uint32_t max_us;
+    uint32_t mean_us;
+    uint32_t stddev_us;
+    uint32_t hist[PERIOD_HIST_BINS];
+} period_summary_t;
+
+void period_monitor_init(period_monitor_t *pm, uint32_t nominal_ms);
+void period_monitor_tick(period_monitor_t *pm); // llamar una vez por activación
+period_summary_t period_monitor_summary(period_monitor_t *pm);
+
+#endif // PERIOD_MONITOR_H
@@ -1,133 +1,144 @@
 // ===== INCLUDES Y CONFIGURACIÓN =====
 #include "potentiometer.h"
 #include "esp_log.h"
-#include "esp_adc/adc_oneshot.h"
-#include "esp_adc/adc_cali.h"
-#include "esp_adc/adc_cali_scheme.h"
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
+#include "adc_filter.h"
+#include "sensor_hal.h"
+#include "esp_cpu.h"
+#include "sdkconfig.h"
 
 static const char *TAG = "POT";
 
 // ===== CONFIGURACIÓN Y VARIABLES GLOBALES =====
-#define DEFAULT_VREF    1100
-#define NO_OF_SAMPLES   8
+#define POT_ADC_ATTEN           ADC_ATTEN_DB_12
+#define POT_MEDIAN_WINDOW       3               // Rechaza tramas aisladas con picos
+#define POT_IIR_SHIFT           2               // Constante de tiempo ~4 tramas (~100 ms)
+#define POT_DEADBAND_RAW        8               // Histéresis para que el LED no parpadee
+#define POT_RAW_MAX             SENSOR_HAL_RAW_MAX
+#define POT_MV_LUT_SIZE         (POT_RAW_MAX + 1)
 
 static const adc_channel_t POT_CHANNEL = ADC_CHANNEL_6;
 
-static adc_oneshot_unit_handle_t adc1_handle;
-static adc_cali_handle_t adc1_cali_handle = NULL;
-static bool do_calibration_init = false;
+static sensor_hal_channel_t pot_hal_channel;
 
-// ===== FUNCIONES DE CALIBRACIÓN DEL ADC =====
-static bool adc_calibration_init(adc_unit_t unit, adc_atten_t atten, adc_cali_handle_t *out_handle)
+// raw -> mV precalculado desde la calibración (curva fija para unidad y atenuación)
+static uint16_t pot_mv_lut[POT_MV_LUT_SIZE];
+
+// Último valor filtrado; lo escribe sólo la tarea de adquisición (escritura de 32 bits atómica)
+static volatile uint32_t latest_raw = 0;
+
+// Cadena de filtrado aplicada a cada valor decimado (sólo la usa la tarea de adquisición)
+static adc_filter_median_t pot_median;
+static adc_filter_iir_t pot_iir;
+static adc_filter_deadband_t pot_deadband;
+
+// ===== TABLA RAW -> mV =====
+static inline uint32_t pot_raw_to_mv(uint32_t raw)
 {
-    adc_cali_handle_t handle = NULL;
-    esp_err_t ret = ESP_FAIL;
-    bool calibrated = false;
-
-#if ADC_CALI_SCHEME_CURVE_FITTING_SUPPORTED
-    if (!calibrated) {
-        ESP_LOGI(TAG, "Intentando calibración por curve fitting...");
-        adc_cali_curve_fitting_config_t cali_config = {
-            .unit_id = unit,
-            .atten = atten,
-            .bitwidth = ADC_BITWIDTH_DEFAULT,
-        };
-        ret = adc_cali_create_scheme_curve_fitting(&cali_config, &handle);
-        if (ret == ESP_OK) {
-            calibrated = true;
-            ESP_LOGI(TAG, "Calibración por curve fitting exitosa");
-        }
+    return pot_mv_lut[raw > POT_RAW_MAX ? POT_RAW_MAX : raw];
+}
+
+#if CONFIG_P5_POT_MV_LUT_BENCHMARK
+static uint32_t pot_raw_to_mv_direct(uint32_t raw)
+{
+    int voltage = 0;
+    ESP_ERROR_CHECK(sensor_hal_raw_to_mv(pot_hal_channel, (int)raw, &voltage));
+    return (uint32_t)voltage;
+}
+
+// Ciclos por conversión: driver de calibración frente a la tabla, y coherencia entre ambos
+static void pot_mv_lut_benchmark(void)
+{
+    volatile uint32_t sink = 0;
+    uint32_t mismatches = 0;
+
+    uint32_t start = esp_cpu_get_cycle_count();
+    for (uint32_t raw = 0; raw < POT_MV_LUT_SIZE; raw++) {
+        sink = pot_raw_to_mv_direct(raw);
     }
-#endif
+    uint32_t direct_cycles = esp_cpu_get_cycle_count() - start;
 
-#if ADC_CALI_SCHEME_LINE_FITTING_SUPPORTED
-    if (!calibrated) {
-        ESP_LOGI(TAG, "Intentando calibración por line fitting...");
-        adc_cali_line_fitting_config_t cali_config = {
-            .unit_id = unit,
-            .atten = atten,
-            .bitwidth = ADC_BITWIDTH_DEFAULT,
-        };
-        ret = adc_cali_create_scheme_line_fitting(&cali_config, &handle);
-        if (ret == ESP_OK) {
-            calibrated = true;
-            ESP_LOGI(TAG, "Calibración por line fitting exitosa");
+    start = esp_cpu_get_cycle_count();
+    for (uint32_t raw = 0; raw < POT_MV_LUT_SIZE; raw++) {
+        sink = pot_raw_to_mv(raw);
+    }
+    uint32_t lut_cycles = esp_cpu_get_cycle_count() - start;
+
+    for (uint32_t raw = 0; raw < POT_MV_LUT_SIZE; raw++) {
+        if (pot_raw_to_mv(raw) != pot_raw_to_mv_direct(raw)) {
+            mismatches++;
         }
     }
+    (void)sink;
+
+    ESP_LOGI(TAG, "Benchmark raw->mV: calibración %lu ciclos/conversión, tabla %lu ciclos/conversión, %lu discrepancias",
+             (unsigned long)(direct_cycles / POT_MV_LUT_SIZE),
+             (unsigned long)(lut_cycles / POT_MV_LUT_SIZE),
+             (unsigned long)mismatches);
+}
 #endif
-    *out_handle = handle;
-    if (ret == ESP_OK) {
-        ESP_LOGI(TAG, "Calibración del ADC exitosa");
-    } else if (ret == ESP_ERR_NOT_SUPPORTED || !calibrated) {
-        ESP_LOGW(TAG, "Calibración no soportada, usando valores sin calibrar");
-    } else {
-        ESP_LOGE(TAG, "Error en la calibración del ADC");
-    }
 
-    return calibrated;
+// ===== FILTRADO DE CADA TRAMA =====
+// Lo invoca la tarea de adquisición de sensor_hal con el promedio de cada trama
+static void pot_on_sample(uint32_t raw, void *arg)
+{
+    raw = adc_filter_median_update(&pot_median, raw);
+    raw = adc_filter_iir_update(&pot_iir, raw);
+    latest_raw = adc_filter_deadband_update(&pot_deadband, raw);
 }
 
 // ===== FUNCIONES DE INICIALIZACIÓN =====
 void pot_init(void)
 {
-    ESP_LOGI(TAG, "Inicializando ADC1 para potenciómetro...");
-    
-    adc_oneshot_unit_init_cfg_t init_config1 = {
-        .unit_id = ADC_UNIT_1,
-    };
-    ESP_ERROR_CHECK(adc_oneshot_new_unit(&init_config1, &adc1_handle));
+    ESP_LOGI(TAG, "Registrando potenciómetro en la adquisición continua de ADC1...");
 
-    adc_oneshot_chan_cfg_t config = {
-        .bitwidth = ADC_BITWIDTH_DEFAULT,
-        .atten = ADC_ATTEN_DB_11,
-    };
-    ESP_ERROR_CHECK(adc_oneshot_config_channel(adc1_handle, POT_CHANNEL, &config));
+    adc_filter_median_init(&pot_median, POT_MEDIAN_WINDOW);
+    adc_filter_iir_init(&pot_iir, POT_IIR_SHIFT);
+    adc_filter_deadband_init(&pot_deadband, POT_DEADBAND_RAW, POT_RAW_MAX);
 
-    do_calibration_init = adc_calibration_init(ADC_UNIT_1, ADC_ATTEN_DB_11, &adc1_cali_handle);
+    sensor_hal_channel_config_t hal_config = {
+        .name = "pot",
+        .unit = ADC_UNIT_1,
+        .channel = POT_CHANNEL,
+        .atten = POT_ADC_ATTEN,
+        .mode = SENSOR_HAL_MODE_CONTINUOUS,
+        .on_sample = pot_on_sample,
+    };
+    ESP_ERROR_CHECK(sensor_hal_channel_register(&hal_config, &pot_hal_channel));
+    ESP_ERROR_CHECK(sensor_hal_build_mv_lut(pot_hal_channel, pot_mv_lut, POT_MV_LUT_SIZE));
+#if CONFIG_P5_POT_MV_LUT_BENCHMARK
+    pot_mv_lut_benchmark();
+#endif
 
-    ESP_LOGI(TAG, "Potenciómetro inicializado en GPIO34 (ADC1_CH6)");
+    ESP_LOGI(TAG, "Potenciómetro registrado en GPIO34 (ADC1_CH6)");
 }
 
-// ===== FUNCIONES DE LECTURA =====
-static int read_raw_avg(void)
+// ===== FUNCIONES PÚBLICAS =====
+// Todas las lecturas devuelven el último valor filtrado en O(1), sin bloquear
+pot_sample_t pot_read(void)
 {
-    int adc_raw[NO_OF_SAMPLES] = {0};
-    int adc_sum = 0;
-    
-    for (int i = 0; i < NO_OF_SAMPLES; i++) {
-        ESP_ERROR_CHECK(adc_oneshot_read(adc1_handle, POT_CHANNEL, &adc_raw[i]));
-        adc_sum += adc_raw[i];
-        vTaskDelay(pdMS_TO_TICKS(10));
+    pot_sample_t sample = {0};
+
+    // Una única instantánea del valor decimado; todos los campos derivan de ella
+    sample.raw = latest_raw;
+    sample.voltage_mv = pot_raw_to_mv(sample.raw);
+
+    const uint32_t MAX_MV = 3300;
+
+    if (sample.voltage_mv >= MAX_MV) {
+        sample.percent = 100;
+    } else {
+        sample.percent = (uint8_t)((sample.voltage_mv * 100) / MAX_MV);
     }
-    
-    return adc_sum / NO_OF_SAMPLES;
+
+    return sample;
 }
 
-// ===== FUNCIONES PÚBLICAS =====
 uint32_t pot_get_voltage_mv(void)
 {
-    int adc_raw = read_raw_avg();
-    int voltage = 0;
-    
-    if (do_calibration_init) {
-        ESP_ERROR_CHECK(adc_cali_raw_to_voltage(adc1_cali_handle, adc_raw, &voltage));
-    } else {
-        voltage = (adc_raw * 3300) / 4095;
-    }
-    
-    return (uint32_t)voltage;
+    return pot_read().voltage_mv;
 }
 
 uint8_t pot_get_percent(void)
 {
-    uint32_t mv = pot_get_voltage_mv();
-    
-    const uint32_t MAX_MV = 3300;
-    
-    if (mv >= MAX_MV) return 100;
-    
-    uint32_t pct = (mv * 100) / MAX_MV;
-    return (uint8_t)pct;
+    return pot_read().percent;
 }
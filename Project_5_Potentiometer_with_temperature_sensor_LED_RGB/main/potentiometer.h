@@ -3,7 +3,15 @@
 
 #include <stdint.h>
 
+// Muestra completa del potenciómetro obtenida de una única adquisición
+typedef struct {
+    uint32_t raw;           // Valor ADC decimado (0..4095)
+    uint32_t voltage_mv;    // Voltaje calibrado en mV
+    uint8_t percent;        // Posición 0..100 derivada de voltage_mv
+} pot_sample_t;
+
 void pot_init(void);
+pot_sample_t pot_read(void); // lectura única de la que derivan todos los campos
 uint8_t pot_get_percent(void); // devuelve 0..100
 uint32_t pot_get_voltage_mv(void); // devuelve mV medido
 
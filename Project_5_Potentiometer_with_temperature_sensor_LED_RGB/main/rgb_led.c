@@ -3,6 +3,9 @@
 #include "driver/ledc.h"
 #include "esp_err.h"
 #include "esp_log.h"
+#include "sdkconfig.h"
+#include "led_pwm.h"
+#include "duty_map.h"
 
 static const char *TAG = "RGB_LED";
 
@@ -14,6 +17,11 @@ static const char *TAG = "RGB_LED";
 #define LEDC_DUTY_RES   LEDC_TIMER_8_BIT
 #define LEDC_FREQUENCY  5000
 
+// duty_map.c no depende del driver LEDC: su rango debe coincidir con la resolución configurada
+_Static_assert(GREEN_DUTY_MAX == (1 << LEDC_DUTY_RES) - 1, "GREEN_DUTY_MAX no coincide con LEDC_DUTY_RES");
+
+static uint32_t applied_duty = 0;   // Último duty pedido al LEDC (el canal arranca en 0)
+
 // ===== FUNCIONES DE INICIALIZACIÓN =====
 void rgb_led_init(void)
 {
@@ -45,6 +53,7 @@ void rgb_led_init(void)
         ESP_LOGE(TAG, "Error configurando canal PWM: %d", err);
         return;
     }
+    led_pwm_init();
 
     ESP_LOGI(TAG, "LED verde inicializado en GPIO %d (8-bit, 5kHz)", GPIO_GREEN);
 }
@@ -54,8 +63,17 @@ void rgb_set_green_percent(uint8_t percent)
 {
     if (percent > 100) percent = 100;
     
-    uint32_t duty = (percent * 255) / 100;
+#if CONFIG_P5_FIXED_POINT
+    uint32_t duty = green_duty_q16(percent);
+#else
+    uint32_t duty = green_duty_div(percent);
+#endif
     
-    ledc_set_duty(LEDC_MODE, LEDC_CHANNEL_G, duty);
-    ledc_update_duty(LEDC_MODE, LEDC_CHANNEL_G);
+    // Sin cambio de consigna no se inicia otro fundido
+    if (duty == applied_duty) {
+        return;
+    }
+    if (led_pwm_set_duty(LEDC_MODE, LEDC_CHANNEL_G, duty) == ESP_OK) {
+        applied_duty = duty;
+    }
 }
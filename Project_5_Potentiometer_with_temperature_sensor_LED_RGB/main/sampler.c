@@ -0,0 +1,111 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "sampler.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+static const char *TAG = "SAMPLER";
+
+// ===== CONFIGURACIÓN Y VARIABLES GLOBALES =====
+#define SAMPLER_MAX_CHANNELS    4
+
+typedef struct {
+    TaskHandle_t task;
+    uint32_t period_ms;
+    int64_t next_release_us;    // Próxima liberación en tiempo absoluto de esp_timer
+} sampler_channel_t;
+
+static sampler_channel_t channels[SAMPLER_MAX_CHANNELS];
+static int channel_count = 0;
+static esp_timer_handle_t sampler_timer = NULL;
+
+// ===== FUNCIONES AUXILIARES =====
+// Libera los canales vencidos y devuelve la próxima liberación de cualquiera de ellos.
+// Los plazos avanzan en múltiplos exactos del periodo desde la fase 0, así que el
+// retardo de despacho de un disparo no se acumula en los siguientes
+static int64_t sampler_release_due(int64_t now_us)
+{
+    int64_t next_us = INT64_MAX;
+
+    for (int i = 0; i < channel_count; i++) {
+        if (channels[i].next_release_us <= now_us) {
+            xTaskNotifyGive(channels[i].task);
+            // Si el disparo llegó más de un periodo tarde, las liberaciones perdidas
+            // se agrupan en una (ulTaskNotifyTake las consumiría juntas de todos modos)
+            do {
+                channels[i].next_release_us += (int64_t)channels[i].period_ms * 1000;
+            } while (channels[i].next_release_us <= now_us);
+        }
+        if (channels[i].next_release_us < next_us) {
+            next_us = channels[i].next_release_us;
+        }
+    }
+    return next_us;
+}
+
+// Se ejecuta en la tarea esp_timer: un temporizador de un solo disparo se rearma
+// para el plazo más cercano, sin ticks intermedios aunque los periodos no tengan
+// un divisor común grande (p. ej. 251 y 2000 ms)
+static void sampler_timer_cb(void *arg)
+{
+    int64_t now_us = esp_timer_get_time();
+    int64_t next_us = sampler_release_due(now_us);
+
+    esp_err_t err = esp_timer_start_once(sampler_timer, (uint64_t)(next_us - now_us));
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error rearmando el temporizador: %s", esp_err_to_name(err));
+    }
+}
+
+// ===== FUNCIONES PÚBLICAS =====
+esp_err_t sampler_register(TaskHandle_t task, uint32_t period_ms)
+{
+    if (task == NULL || period_ms == 0 || sampler_timer != NULL) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (channel_count >= SAMPLER_MAX_CHANNELS) {
+        return ESP_ERR_NO_MEM;
+    }
+    channels[channel_count].task = task;
+    channels[channel_count].period_ms = period_ms;
+    channel_count++;
+    return ESP_OK;
+}
+
+esp_err_t sampler_start(void)
+{
+    if (channel_count == 0) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const esp_timer_create_args_t timer_args = {
+        .callback = sampler_timer_cb,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "sampler",
+    };
+    esp_err_t err = esp_timer_create(&timer_args, &sampler_timer);
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error creando el temporizador: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    // Liberar todas las tareas inmediatamente (fase 0) y después en cada plazo
+    int64_t now_us = esp_timer_get_time();
+    for (int i = 0; i < channel_count; i++) {
+        channels[i].next_release_us = now_us;
+    }
+    int64_t next_us = sampler_release_due(now_us);
+    err = esp_timer_start_once(sampler_timer, (uint64_t)(next_us - now_us));
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error arrancando el temporizador: %s", esp_err_to_name(err));
+        return err;
+    }
+
+    ESP_LOGI(TAG, "Muestreo planificado: %d canales, temporizador rearmado en cada plazo",
+             channel_count);
+    return ESP_OK;
+}
+
+void sampler_wait(void)
+{
+    ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+}
@@ -0,0 +1,15 @@
+#ifndef SAMPLER_H
+#define SAMPLER_H
+
+#include <stdint.h>
+#include "esp_err.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+// Planificador de muestreo: un único esp_timer de un solo disparo libera cada tarea de
+// lectura en múltiplos exactos de su periodo, todas alineadas en fase al arranque
+esp_err_t sampler_register(TaskHandle_t task, uint32_t period_ms); // antes de sampler_start
+esp_err_t sampler_start(void);
+void sampler_wait(void); // bloquea la tarea llamante hasta su próxima liberación
+
+#endif // SAMPLER_H
@@ -0,0 +1,186 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "sys_stats.h"
+
+#if CONFIG_P5_TASK_STATS
+
+#include <stdio.h>
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "task_config.h"
+
+static const char *TAG = "SYS_STATS";
+
+// ===== CONFIGURACIÓN Y VARIABLES GLOBALES =====
+#define STATS_MAX_TASKS         12      // Tareas instrumentadas
+#define STATS_MAX_SNAPSHOT      32      // Tareas totales que caben en la instantánea
+#define STATS_MAX_PERIODS       4       // Monitores de periodo registrados
+#define STATS_MAX_COUNTERS      8       // Contadores de eventos registrados
+#define STATS_TASK_STACK        3072
+
+typedef struct {
+    TaskHandle_t handle;
+    configRUN_TIME_COUNTER_TYPE last_runtime;
+} stats_entry_t;
+
+static stats_entry_t entries[STATS_MAX_TASKS];
+static int entry_count = 0;
+static struct {
+    const char *name;
+    period_monitor_t *monitor;
+} periods[STATS_MAX_PERIODS];
+static int period_count = 0;
+static struct {
+    const char *name;
+    const volatile uint32_t *counter;
+} counters[STATS_MAX_COUNTERS];
+static int counter_count = 0;
+static TaskStatus_t snapshot[STATS_MAX_SNAPSHOT];
+static configRUN_TIME_COUNTER_TYPE last_idle_runtime[portNUM_PROCESSORS];
+static configRUN_TIME_COUNTER_TYPE last_total_runtime = 0;
+
+// ===== FUNCIONES AUXILIARES =====
+static const TaskStatus_t *find_status(TaskHandle_t handle, UBaseType_t count)
+{
+    for (UBaseType_t i = 0; i < count; i++) {
+        if (snapshot[i].xHandle == handle) {
+            return &snapshot[i];
+        }
+    }
+    return NULL;
+}
+
+static uint32_t permille(configRUN_TIME_COUNTER_TYPE part, configRUN_TIME_COUNTER_TYPE whole)
+{
+    return (whole == 0) ? 0 : (uint32_t)(((uint64_t)part * 1000) / whole);
+}
+
+// Formato de salida (una línea por registro):
+//   @task,<ms>,<nombre>,<afinidad>,<pila_libre_min_bytes>,<cpu_por_mil>
+//   @idle,<ms>,<núcleo>,<ocioso_por_mil>
+//   @period,<ms>,<nombre>,<n>,<min_us>,<max_us>,<media_us>,<desv_tipica_us>
+//   @jitter,<ms>,<nombre>,<h0>,...,<h7>   (clases de PERIOD_HIST_LIMITS_US)
+//   @count,<ms>,<nombre>,<valor>           (acumulado desde el arranque)
+// La CPU de cada tarea se expresa sobre la capacidad total de todos los núcleos
+// y el tiempo ocioso sobre la de su núcleo, ambos desde la muestra anterior.
+static void emit_stats(void)
+{
+    configRUN_TIME_COUNTER_TYPE total_runtime = 0;
+    UBaseType_t count = uxTaskGetSystemState(snapshot, STATS_MAX_SNAPSHOT, &total_runtime);
+    if (count == 0) {
+        ESP_LOGW(TAG, "Instantánea incompleta: aumente STATS_MAX_SNAPSHOT");
+        return;
+    }
+
+    configRUN_TIME_COUNTER_TYPE elapsed = total_runtime - last_total_runtime;
+    last_total_runtime = total_runtime;
+    uint32_t now_ms = (uint32_t)(esp_timer_get_time() / 1000);
+
+    for (int i = 0; i < entry_count; i++) {
+        const TaskStatus_t *status = find_status(entries[i].handle, count);
+        if (status == NULL) {
+            continue;
+        }
+        configRUN_TIME_COUNTER_TYPE delta = status->ulRunTimeCounter - entries[i].last_runtime;
+        entries[i].last_runtime = status->ulRunTimeCounter;
+
+        BaseType_t affinity = xTaskGetCoreID(status->xHandle);
+        printf("@task,%lu,%s,%d,%lu,%lu\n", (unsigned long)now_ms, status->pcTaskName,
+               affinity == tskNO_AFFINITY ? -1 : (int)affinity,
+               (unsigned long)status->usStackHighWaterMark,
+               (unsigned long)permille(delta, elapsed * portNUM_PROCESSORS));
+    }
+
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        const TaskStatus_t *idle = find_status(xTaskGetIdleTaskHandleForCore(core), count);
+        if (idle == NULL) {
+            continue;
+        }
+        configRUN_TIME_COUNTER_TYPE delta = idle->ulRunTimeCounter - last_idle_runtime[core];
+        last_idle_runtime[core] = idle->ulRunTimeCounter;
+        printf("@idle,%lu,%d,%lu\n", (unsigned long)now_ms, core,
+               (unsigned long)permille(delta, elapsed));
+    }
+
+    for (int i = 0; i < period_count; i++) {
+        period_summary_t summary = period_monitor_summary(periods[i].monitor);
+        printf("@period,%lu,%s,%lu,%lu,%lu,%lu,%lu\n", (unsigned long)now_ms, periods[i].name,
+               (unsigned long)summary.count, (unsigned long)summary.min_us,
+               (unsigned long)summary.max_us, (unsigned long)summary.mean_us,
+               (unsigned long)summary.stddev_us);
+
+        printf("@jitter,%lu,%s", (unsigned long)now_ms, periods[i].name);
+        for (int bin = 0; bin < PERIOD_HIST_BINS; bin++) {
+            printf(",%lu", (unsigned long)summary.hist[bin]);
+        }
+        printf("\n");
+    }
+
+    for (int i = 0; i < counter_count; i++) {
+        printf("@count,%lu,%s,%lu\n", (unsigned long)now_ms, counters[i].name,
+               (unsigned long)*counters[i].counter);
+    }
+}
+
+static void sys_stats_task(void *arg)
+{
+    TickType_t last_wake = xTaskGetTickCount();
+
+    while (1) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(CONFIG_P5_TASK_STATS_PERIOD_MS));
+        emit_stats();
+    }
+}
+
+// ===== FUNCIONES PÚBLICAS =====
+void sys_stats_register_task(TaskHandle_t task)
+{
+    if (task == NULL) {
+        return;
+    }
+    if (entry_count >= STATS_MAX_TASKS) {
+        ESP_LOGW(TAG, "Registro de tareas lleno, se ignora %s", pcTaskGetName(task));
+        return;
+    }
+    entries[entry_count].handle = task;
+    entries[entry_count].last_runtime = 0;
+    entry_count++;
+}
+
+void sys_stats_register_period(const char *name, period_monitor_t *monitor)
+{
+    if (period_count >= STATS_MAX_PERIODS) {
+        ESP_LOGW(TAG, "Registro de periodos lleno, se ignora %s", name);
+        return;
+    }
+    periods[period_count].name = name;
+    periods[period_count].monitor = monitor;
+    period_count++;
+}
+
+void sys_stats_register_counter(const char *name, const volatile uint32_t *counter)
+{
+    if (counter_count >= STATS_MAX_COUNTERS) {
+        ESP_LOGW(TAG, "Registro de contadores lleno, se ignora %s", name);
+        return;
+    }
+    counters[counter_count].name = name;
+    counters[counter_count].counter = counter;
+    counter_count++;
+}
+
+void sys_stats_start(void)
+{
+    TaskHandle_t handle = NULL;
+
+    if (xTaskCreatePinnedToCore(sys_stats_task, "sys_stats_task", STATS_TASK_STACK, NULL,
+                                P5_PRIO_STATS, &handle, P5_CORE_UI) != pdPASS) {
+        ESP_LOGE(TAG, "Error creando la tarea de instrumentación");
+        return;
+    }
+    sys_stats_register_task(handle);
+
+    ESP_LOGI(TAG, "Instrumentación activa cada %d ms (%d tareas)",
+             CONFIG_P5_TASK_STATS_PERIOD_MS, entry_count);
+}
+
+#endif // CONFIG_P5_TASK_STATS
@@ -0,0 +1,23 @@
+#ifndef SYS_STATS_H
+#define SYS_STATS_H
+
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "period_monitor.h"
+
+// Instrumentación periódica: marca de agua de pila, uso de CPU por tarea y
+// tiempo ocioso por núcleo, emitidos en líneas CSV con prefijo '@'
+#if CONFIG_P5_TASK_STATS
+void sys_stats_register_task(TaskHandle_t task);
+void sys_stats_register_period(const char *name, period_monitor_t *monitor);
+void sys_stats_register_counter(const char *name, const volatile uint32_t *counter);
+void sys_stats_start(void);
+#else
+static inline void sys_stats_register_task(TaskHandle_t task) { (void)task; }
+static inline void sys_stats_register_period(const char *name, period_monitor_t *monitor) { (void)name; (void)monitor; }
+static inline void sys_stats_register_counter(const char *name, const volatile uint32_t *counter) { (void)name; (void)counter; }
+static inline void sys_stats_start(void) { }
+#endif
+
+#endif // SYS_STATS_H
@@ -0,0 +1,24 @@
+#ifndef TASK_CONFIG_H
+#define TASK_CONFIG_H
+
+#include "sdkconfig.h"
+#include "freertos/FreeRTOS.h"
+
+// ===== PLAN DE NÚCLEOS =====
+// Adquisición y actuación en un núcleo; registro, monitor e instrumentación en el otro
+#if CONFIG_P5_PIN_TASKS
+#define P5_CORE_RT              CONFIG_P5_RT_CORE
+#define P5_CORE_UI              (1 - CONFIG_P5_RT_CORE)
+#else
+#define P5_CORE_RT              tskNO_AFFINITY
+#define P5_CORE_UI              tskNO_AFFINITY
+#endif
+
+// ===== PLAN DE PRIORIDADES =====
+#define P5_PRIO_ADC             6   // Consumo de tramas DMA del ADC
+#define P5_PRIO_SENSOR          5   // Lectura de sensores
+#define P5_PRIO_ACTUATOR        4   // Control de LEDs
+#define P5_PRIO_DISPLAY         3   // Monitor serie
+#define P5_PRIO_STATS           2   // Instrumentación
+
+#endif // TASK_CONFIG_H
@@ -0,0 +1,123 @@
+// ===== INCLUDES Y CONFIGURACIÓN =====
+#include "telemetry.h"
+#include <stdio.h>
+#include <stddef.h>
+#include <unistd.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/ringbuf.h"
+#include "driver/uart.h"
+#include "driver/uart_vfs.h"
+#include "esp_log.h"
+#include "sdkconfig.h"
+#include "task_config.h"
+
+static const char *TAG = "TELEMETRY";
+
+// ===== CONFIGURACIÓN Y VARIABLES GLOBALES =====
+#define TELEMETRY_RING_BYTES    1024    // ~36 tramas con la cabecera del anillo
+#define TELEMETRY_TASK_STACK    2560
+#define TELEMETRY_TASK_PRIO     1       // Sólo vacía el anillo cuando nada más tiene trabajo
+#define TELEMETRY_UART          CONFIG_ESP_CONSOLE_UART_NUM
+#define TELEMETRY_UART_RX_BYTES 256     // Mínimo que admite el driver (mayor que la FIFO)
+#define TELEMETRY_UART_TX_BYTES 1024    // Las escrituras vuelven sin esperar a que salga la trama
+
+_Static_assert(sizeof(telemetry_frame_t) == 18, "telemetry_frame_t debe ocupar 18 bytes");
+
+static RingbufHandle_t telemetry_ring = NULL;
+static uint8_t next_seq = 0;
+static volatile uint32_t dropped_frames = 0;
+
+// ===== FUNCIONES AUXILIARES =====
+static uint8_t crc8(const uint8_t *data, size_t length)
+{
+    uint8_t crc = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0x07) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// El único punto que toca la consola: se ejecuta con la prioridad más baja.
+// Las tramas van directamente al driver de la UART: stdout convertiría cada 0x0A
+// en 0x0D 0x0A (rompiendo el CRC) y competiría por su cerrojo con los logs.
+static void telemetry_tx_task(void *arg)
+{
+    size_t length = 0;
+
+    while (1) {
+        uint8_t *item = xRingbufferReceive(telemetry_ring, &length, portMAX_DELAY);
+        if (item == NULL) {
+            continue;
+        }
+        // Cada trama sale en una única escritura: el driver no intercala otros datos en ella
+        uart_write_bytes(TELEMETRY_UART, item, length);
+        vRingbufferReturnItem(telemetry_ring, item);
+    }
+}
+
+// Instala el driver en la UART de la consola y hace que la VFS (printf, ESP_LOG) lo use también
+static esp_err_t telemetry_uart_init(void)
+{
+    if (!uart_is_driver_installed(TELEMETRY_UART)) {
+        esp_err_t err = uart_driver_install(TELEMETRY_UART, TELEMETRY_UART_RX_BYTES, TELEMETRY_UART_TX_BYTES,
+                                            0, NULL, 0);
+        if (err != ESP_OK) {
+            return err;
+        }
+    }
+    // Lo ya escrito por la VFS debe salir antes de cambiar de camino
+    fflush(stdout);
+    fsync(fileno(stdout));
+    uart_vfs_dev_use_driver(TELEMETRY_UART);
+    return ESP_OK;
+}
+
+// ===== FUNCIONES PÚBLICAS =====
+void telemetry_init(void)
+{
+    esp_err_t err = telemetry_uart_init();
+    if (err != ESP_OK) {
+        ESP_LOGE(TAG, "Error instalando el driver de la UART de la consola: %s", esp_err_to_name(err));
+        return;
+    }
+
+    telemetry_ring = xRingbufferCreate(TELEMETRY_RING_BYTES, RINGBUF_TYPE_NOSPLIT);
+    if (telemetry_ring == NULL) {
+        ESP_LOGE(TAG, "Error creando el anillo de telemetría");
+        return;
+    }
+
+    if (xTaskCreatePinnedToCore(telemetry_tx_task, "telemetry_tx_task", TELEMETRY_TASK_STACK, NULL,
+                                TELEMETRY_TASK_PRIO, NULL, P5_CORE_UI) != pdPASS) {
+        ESP_LOGE(TAG, "Error creando la tarea de telemetría");
+        return;
+    }
+
+    ESP_LOGI(TAG, "Telemetría binaria activa (%u bytes/trama)", (unsigned)sizeof(telemetry_frame_t));
+}
+
+bool telemetry_send(telemetry_frame_t *frame)
+{
+    frame->sync[0] = TELEMETRY_SYNC0;
+    frame->sync[1] = TELEMETRY_SYNC1;
+    frame->version = TELEMETRY_VERSION;
+    frame->seq = next_seq++;
+    frame->crc8 = crc8((const uint8_t *)frame, offsetof(telemetry_frame_t, crc8));
+
+    if (telemetry_ring == NULL ||
+        xRingbufferSend(telemetry_ring, frame, sizeof(*frame), 0) != pdTRUE) {
+        dropped_frames++;
+        return false;
+    }
+    return true;
+}
+
+uint32_t telemetry_dropped(void)
+{
+    return dropped_frames;
+}
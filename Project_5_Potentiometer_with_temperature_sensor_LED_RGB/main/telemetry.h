@@ -0,0 +1,31 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TELEMETRY_SYNC0         0xA5
+#define TELEMETRY_SYNC1         0x5A
+#define TELEMETRY_VERSION       1
+
+// Trama binaria de telemetría (little-endian, 18 bytes). El formato lo decodifica
+// tools/telemetry_decode.py; cualquier cambio aquí debe reflejarse allí.
+typedef struct __attribute__((packed)) {
+    uint8_t sync[2];            // TELEMETRY_SYNC0, TELEMETRY_SYNC1
+    uint8_t version;            // TELEMETRY_VERSION
+    uint8_t seq;                // Contador de tramas (detecta pérdidas)
+    uint32_t timestamp_ms;      // Tiempo desde el arranque
+    uint16_t pot_mv;            // Voltaje del potenciómetro
+    uint8_t pot_percent;        // Posición del potenciómetro 0..100
+    uint16_t ntc_raw;           // Código ADC del NTC
+    int16_t temperature_cc;     // Temperatura en centésimas de °C
+    uint16_t ntc_duty;          // Duty aplicado al LED rojo
+    uint8_t crc8;               // CRC-8 (polinomio 0x07) de todos los bytes anteriores
+} telemetry_frame_t;
+
+void telemetry_init(void);
+// Encola la trama sin bloquear; devuelve false si el anillo está lleno y se descarta
+bool telemetry_send(telemetry_frame_t *frame);
+uint32_t telemetry_dropped(void);
+
+#endif // TELEMETRY_H
@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+"""Decodifica las tramas binarias de telemetría del Proyecto 5.
+
+Lee del puerto serie (requiere pyserial) o de un fichero/stdin y escribe cada
+trama válida como texto legible o como CSV. Los bytes que no forman parte de
+una trama (logs de arranque, ESP_LOG...) se descartan.
+
+Ejemplos:
+    python tools/telemetry_decode.py --port /dev/ttyUSB0
+    python tools/telemetry_decode.py --port /dev/ttyUSB0 --csv > datos.csv
+    python tools/telemetry_decode.py captura.bin --csv
+"""
+import argparse
+import struct
+import sys
+
+SYNC = b'\xa5\x5a'
+VERSION = 1
+# Debe coincidir con telemetry_frame_t en main/telemetry.h
+FRAME = struct.Struct('<2sBBIHBHhHB')
+CSV_HEADER = 'seq,timestamp_ms,pot_mv,pot_percent,ntc_raw,temperature_c,ntc_duty'
+
+
+def crc8(data: bytes) -> int:
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def frames(chunks):
+    """Genera tuplas decodificadas a partir de bloques de bytes arbitrarios."""
+    buffer = bytearray()
+    for chunk in chunks:
+        buffer.extend(chunk)
+        while True:
+            start = buffer.find(SYNC)
+            if start < 0:
+                # Conservar un posible primer byte de sincronía al final
+                del buffer[:max(0, len(buffer) - 1)]
+                break
+            del buffer[:start]
+            if len(buffer) < FRAME.size:
+                break
+            raw = bytes(buffer[:FRAME.size])
+            fields = FRAME.unpack(raw)
+            if fields[1] != VERSION or crc8(raw[:-1]) != fields[-1]:
+                # Falsa sincronía: avanzar un byte y volver a buscar
+                del buffer[:1]
+                continue
+            del buffer[:FRAME.size]
+            yield fields[2:-1]
+
+
+def read_chunks(args):
+    if args.port:
+        import serial  # pyserial
+        with serial.Serial(args.port, args.baud, timeout=0.1) as port:
+            while True:
+                yield port.read(256)
+    else:
+        stream = open(args.file, 'rb') if args.file else sys.stdin.buffer
+        with stream:
+            while True:
+                chunk = stream.read(4096)
+                if not chunk:
+                    return
+                yield chunk
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument('file', nargs='?', help='captura binaria (por defecto stdin)')
+    parser.add_argument('--port', help='puerto serie, p. ej. /dev/ttyUSB0')
+    parser.add_argument('--baud', type=int, default=115200)
+    parser.add_argument('--csv', action='store_true', help='salida CSV en lugar de texto')
+    args = parser.parse_args()
+
+    if args.csv:
+        print(CSV_HEADER)
+
+    last_seq = None
+    lost = 0
+    try:
+        for seq, ts, pot_mv, pot_pct, ntc_raw, temp_cc, duty in frames(read_chunks(args)):
+            if last_seq is not None:
+                lost += (seq - last_seq - 1) & 0xFF
+            last_seq = seq
+            temperature = temp_cc / 100.0
+            if args.csv:
+                print(f'{seq},{ts},{pot_mv},{pot_pct},{ntc_raw},{temperature:.2f},{duty}', flush=True)
+            else:
+                print(f'[{ts:>10} ms #{seq:03}] Potenciómetro: {pot_mv} mV ({pot_pct}%) | '
+                      f'NTC raw {ntc_raw}: {temperature:.2f}°C | duty LED rojo {duty}', flush=True)
+    except KeyboardInterrupt:
+        pass
+    finally:
+        if lost:
+            print(f'Tramas perdidas: {lost}', file=sys.stderr)
+
+
+if __name__ == '__main__':
+    main()